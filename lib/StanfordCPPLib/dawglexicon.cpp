@@ -11,10 +11,16 @@
  * format.  The STL set is for words added piecemeal at runtime.
  *
  * The DAWG idea comes from an article by Appel & Jacobson, CACM May 1988.
- * This lexicon implementation only has the code to load/search the DAWG.
- * The DAWG builder code is quite a bit more intricate, see Julie Zelenski
- * if you need it.
+ * This lexicon implementation loads and searches the DAWG, and can build
+ * a new one from its words with the incremental algorithm of Daciuk,
+ * Mihov, Watson & Watson (Computational Linguistics 26:1, March 2000).
  * 
+ * @version 2026/10/18
+ * - added cursor method and DawgLexicon::Cursor class
+ * - added native-endian binary format (read with mmap) and writeBinaryFile
+ * - BUGFIX: loading a binary file twice or assigning no longer leaks the edges
+ * - added compile method and the DawgBuilder class behind it
+ * - findEdgeForChar searches four edges at a time with SSE2
  * @version 2014/11/13
  * - added comparison operators <, >=, etc.
  * - added hashCode function
@@ -25,6 +31,16 @@
  * - BUGFIX: operator << now shows "" marks around words to match Lexicon
  */
 
+#ifndef _WIN32
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
 #include "dawglexicon.h"
 #include <algorithm>
 #include <cstdlib>
@@ -34,6 +50,9 @@
 #include <sstream>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "compare.h"
 #include "error.h"
 #include "hashcode.h"
@@ -41,6 +60,27 @@
 
 static uint32_t my_ntohl(uint32_t arg);
 
+/*
+ * Header of the native binary format.  The edges follow it directly, as
+ * 32-bit words in the byte order of the machine that wrote the file, so
+ * they can be used in place.  A machine of the other byte order reads
+ * byteOrder as BYTE_ORDER_SWAPPED and swaps the edges as it loads them.
+ */
+struct NativeDawgHeader {
+    char magic[8];          // NATIVE_MAGIC
+    uint32_t byteOrder;     // BYTE_ORDER_MARK as written
+    uint32_t version;       // NATIVE_VERSION
+    uint32_t startIndex;    // index of the first edge out of the root
+    uint32_t numEdges;
+    uint32_t numWords;
+    uint32_t reserved;      // 0
+};
+
+static const char NATIVE_MAGIC[8] = { 'D', 'A', 'W', 'G', 'B', 'I', 'N', '\0' };
+static const uint32_t NATIVE_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const uint32_t BYTE_ORDER_SWAPPED = 0x04030201;
+
 /*
  * The DAWG is stored as an array of edges. Each edge is represented by
  * one 32-bit struct.  The 5 "letter" bits indicate the character on this
@@ -54,23 +94,153 @@ static uint32_t my_ntohl(uint32_t arg);
  * machines.
  */
 
+/*
+ * Class: DawgBuilder
+ * ------------------
+ * Builds a minimal DAWG from words supplied in alphabetical order.  The
+ * words are added to a trie one at a time, but only the path of the most
+ * recent word is ever left unminimized: when a word arrives, the part of
+ * the previous word's path that it does not share can no longer change, so
+ * each of those states is either swapped for an identical state found
+ * earlier or entered into the register of unique states.  As in the edge
+ * format, acceptance belongs to the arc that ends a word rather than to the
+ * state it leads to, so two states are identical when they have the same
+ * arcs, with the same acceptance, to the same targets.  That is easy to
+ * check because every target has already been made unique.  States that are swapped out go on a free list to be
+ * reused, so the builder never holds much more than the finished DAWG.
+ */
+namespace {
+class DawgBuilder {
+public:
+    struct Arc {
+        int letter;                                 // 1 for 'a' through 26 for 'z'
+        int target;
+        bool accept;                                // a word ends with this arc
+    };
+
+    struct State {
+        std::vector<Arc> arcs;                      // in letter order
+    };
+
+    DawgBuilder() {
+        m_root = newState();
+        m_numWords = 0;
+    }
+
+    // pre: word is made of 'a'-'z' and sorts after every earlier word
+    void addWord(const std::string& word) {
+        size_t common = 0;
+        int state = m_root;
+        while (common < word.length() && common < m_previous.length()
+               && word[common] == m_previous[common]) {
+            state = m_states[state].arcs.back().target;
+            common++;
+        }
+        if (common == word.length() && common == m_previous.length() && m_numWords > 0) {
+            return;     // duplicate
+        }
+        if (!m_states[state].arcs.empty()) {
+            replaceOrRegister(state);
+        }
+        for (size_t i = common; i < word.length(); i++) {
+            Arc arc = { word[i] - 'a' + 1, newState(), i + 1 == word.length() };
+            m_states[state].arcs.push_back(arc);
+            state = arc.target;
+        }
+        m_previous = word;
+        m_numWords++;
+    }
+
+    void finish() {
+        if (!m_states[m_root].arcs.empty()) {
+            replaceOrRegister(m_root);
+        }
+    }
+
+    int root() const {
+        return m_root;
+    }
+
+    int numWords() const {
+        return m_numWords;
+    }
+
+    const State& state(int index) const {
+        return m_states[index];
+    }
+
+private:
+    int newState() {
+        int index;
+        if (m_freeStates.empty()) {
+            index = (int) m_states.size();
+            m_states.push_back(State());
+        } else {
+            index = m_freeStates.back();
+            m_freeStates.pop_back();
+            m_states[index].arcs.clear();
+        }
+        return index;
+    }
+
+    // minimizes the states below the last arc of state, deepest first
+    void replaceOrRegister(int state) {
+        int child = m_states[state].arcs.back().target;
+        if (!m_states[child].arcs.empty()) {
+            replaceOrRegister(child);
+        }
+        std::string key = signature(child);
+        std::unordered_map<std::string, int>::const_iterator found = m_register.find(key);
+        if (found != m_register.end()) {
+            m_states[state].arcs.back().target = found->second;
+            m_freeStates.push_back(child);
+        } else {
+            m_register[key] = child;
+        }
+    }
+
+    std::string signature(int index) const {
+        const State& s = m_states[index];
+        std::string key;
+        for (size_t i = 0; i < s.arcs.size(); i++) {
+            key += (char) (s.arcs[i].accept ? s.arcs[i].letter + 32 : s.arcs[i].letter);
+            key.append((const char*) &s.arcs[i].target, sizeof(int));
+        }
+        return key;
+    }
+
+    std::vector<State> m_states;
+    std::vector<int> m_freeStates;
+    std::unordered_map<std::string, int> m_register;
+    std::string m_previous;
+    int m_root;
+    int m_numWords;
+};
+}
+
 DawgLexicon::DawgLexicon() {
     edges = start = NULL;
     numEdges = numDawgWords = 0;
+    mappedFile = NULL;
+    mappedSize = 0;
 }
 
 DawgLexicon::DawgLexicon(const std::string& filename) {
     edges = start = NULL;
     numEdges = numDawgWords = 0;
+    mappedFile = NULL;
+    mappedSize = 0;
     addWordsFromFile(filename);
 }
 
 DawgLexicon::DawgLexicon(const DawgLexicon& src) {
+    mappedFile = NULL;
+    mappedSize = 0;
     deepCopy(src);
 }
 
 DawgLexicon::~DawgLexicon() {
-    if (edges) delete[] edges;
+    releaseEdges();
 }
 
 void DawgLexicon::add(const std::string& word) {
@@ -109,9 +279,7 @@ void DawgLexicon::addWordsFromFile(const std::string& filename) {
 }
 
 void DawgLexicon::clear() {
-    if (edges) {
-        delete[] edges;
-    }
+    releaseEdges();
     edges = start = NULL;
     numEdges = numDawgWords = 0;
     otherWords.clear();
@@ -127,6 +295,75 @@ bool DawgLexicon::contains(const std::string& word) const {
     return otherWords.contains(copy);
 }
 
+/*
+ * Implementation notes: compile
+ * -----------------------------
+ * Iteration already merges the DAWG's words with the added ones in
+ * alphabetical order, which is the order DawgBuilder needs.  The finished
+ * states are then laid out breadth-first from the root, each state's arcs
+ * becoming one run of edges, so the root's run starts at index 0 and no
+ * child pointer (which uses 0 to mean "no children") ever needs index 0.
+ */
+void DawgLexicon::compile() {
+    DawgBuilder builder;
+    for (std::string word : *this) {
+        for (size_t i = 0; i < word.length(); i++) {
+            if (word[i] < 'a' || word[i] > 'z') {
+                error("DawgLexicon::compile: Word cannot be stored in a DAWG: " + word);
+            }
+        }
+        if (!word.empty()) {
+            builder.addWord(word);
+        }
+    }
+    builder.finish();
+
+    std::vector<int> order;
+    std::unordered_map<int, int> runStart;
+    int total = 0;
+    if (!builder.state(builder.root()).arcs.empty()) {
+        order.push_back(builder.root());
+        runStart[builder.root()] = 0;
+        total = (int) builder.state(builder.root()).arcs.size();
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        const DawgBuilder::State& state = builder.state(order[i]);
+        for (size_t k = 0; k < state.arcs.size(); k++) {
+            int target = state.arcs[k].target;
+            if (!builder.state(target).arcs.empty() && runStart.count(target) == 0) {
+                runStart[target] = total;
+                total += (int) builder.state(target).arcs.size();
+                order.push_back(target);
+            }
+        }
+    }
+    if (total >= (1 << 24)) {
+        error("DawgLexicon::compile: Too many words for a DAWG");
+    }
+
+    Edge* newEdges = (total == 0) ? NULL : new Edge[total];
+    for (size_t i = 0; i < order.size(); i++) {
+        const DawgBuilder::State& state = builder.state(order[i]);
+        Edge* edge = newEdges + runStart[order[i]];
+        for (size_t k = 0; k < state.arcs.size(); k++, edge++) {
+            const DawgBuilder::Arc& arc = state.arcs[k];
+            const DawgBuilder::State& target = builder.state(arc.target);
+            edge->letter = arc.letter;
+            edge->lastEdge = (k + 1 == state.arcs.size());
+            edge->accept = arc.accept;
+            edge->unused = 0;
+            edge->children = target.arcs.empty() ? 0 : runStart[arc.target];
+        }
+    }
+
+    releaseEdges();
+    edges = newEdges;
+    start = newEdges;
+    numEdges = total;
+    numDawgWords = builder.numWords();
+    otherWords.clear();
+}
+
 bool DawgLexicon::containsPrefix(const std::string& prefix) const {
     if (prefix.empty()) return true;
     std::string copy = prefix;
@@ -139,6 +376,10 @@ bool DawgLexicon::containsPrefix(const std::string& prefix) const {
     return false;
 }
 
+DawgLexicon::Cursor DawgLexicon::cursor() const {
+    return Cursor(this, NULL);
+}
+
 bool DawgLexicon::equals(const DawgLexicon& lex2) const {
     // optimization: if literally same lexicon, stop
     if (this == &lex2) {
@@ -249,11 +490,44 @@ void DawgLexicon::deepCopy(const DawgLexicon& src) {
  * matches the given char.  Returns NULL if we get to
  * last child without finding a match (thus no such
  * child edge exists).
+ *
+ * Where the compiler targets SSE2, the edge list is searched four edges
+ * at a time.  A block of edges is loaded as 32-bit lanes, and two
+ * compares give a bit mask of the lanes holding the letter and a mask of
+ * the lanes marked lastEdge; a match counts only if no lastEdge comes
+ * before it.  Loads never reach past the end of the edge array: the last
+ * few edges of the array are always searched one at a time, which is also
+ * what happens on every other platform.  The vector code relies on the
+ * little-endian edge layout, in which letter is the low 5 bits and
+ * lastEdge the next bit.  Wider AVX2 blocks were tried and were no faster:
+ * most edge lists are shorter than four edges, so the extra lanes are
+ * nearly always wasted.
  */
 DawgLexicon::Edge* DawgLexicon::findEdgeForChar(Edge* children, char ch) const {
+    unsigned int ord = charToOrd(ch);
     Edge* curEdge = children;
+#if defined(__SSE2__) && defined(BYTE_ORDER) && BYTE_ORDER == LITTLE_ENDIAN
+    const __m128i letterMask = _mm_set1_epi32(0x1F);
+    const __m128i lastMask = _mm_set1_epi32(0x20);
+    const __m128i target = _mm_set1_epi32((int) ord);
+    while (curEdge + 4 <= edges + numEdges) {
+        __m128i block = _mm_loadu_si128((const __m128i*) curEdge);
+        __m128i found = _mm_cmpeq_epi32(_mm_and_si128(block, letterMask), target);
+        __m128i last = _mm_cmpeq_epi32(_mm_and_si128(block, lastMask), lastMask);
+        int foundBits = _mm_movemask_ps(_mm_castsi128_ps(found));
+        int lastBits = _mm_movemask_ps(_mm_castsi128_ps(last));
+        int validBits = (lastBits == 0) ? 0xF : ((lastBits & -lastBits) << 1) - 1;
+        if (foundBits & validBits) {
+            return curEdge + __builtin_ctz(foundBits & validBits);
+        }
+        if (lastBits != 0) {
+            return NULL;
+        }
+        curEdge += 4;
+    }
+#endif
     while (true) {
-        if (curEdge->letter == charToOrd(ch)) {
+        if (curEdge->letter == ord) {
             return curEdge;
         }
         if (curEdge->lastEdge) return NULL;
@@ -264,10 +538,19 @@ DawgLexicon::Edge* DawgLexicon::findEdgeForChar(Edge* children, char ch) const {
 /*
  * Implementation notes: readBinaryFile
  * ------------------------------------
- * The binary lexicon file format must follow this pattern:
+ * The original binary lexicon file format must follow this pattern:
  * DAWG:<startnode index>:<num bytes>:<num bytes block of edge data>
+ * Files in the native format, which also begin with "DAWG", are handed
+ * off to readNativeBinaryFile.
  */
 void DawgLexicon::readBinaryFile(const std::string& filename) {
+    releaseEdges();
+    edges = start = NULL;
+    numEdges = numDawgWords = 0;
+    if (readNativeBinaryFile(filename)) {
+        return;
+    }
+
     long startIndex, numBytes;
     char firstFour[4], expected[] = "DAWG";
 #ifdef _foreachpatch_h
@@ -308,6 +591,132 @@ void DawgLexicon::readBinaryFile(const std::string& filename) {
     numDawgWords = countDawgWords(start);
 }
 
+/*
+ * Implementation notes: readNativeBinaryFile
+ * ------------------------------------------
+ * Returns false, having read nothing, if the file is not in the native
+ * format.  Otherwise the file is mapped into memory read-only and the edge
+ * array is used right where it sits in the mapping.  The word count comes
+ * from the header, so loading touches nothing but the header page; the
+ * rest of the file is paged in as searches reach it.  If the file was
+ * written on a machine of the other byte order, or the platform has no
+ * mmap, the edges are read into a new array instead.
+ */
+bool DawgLexicon::readNativeBinaryFile(const std::string& filename) {
+    NativeDawgHeader header;
+    std::ifstream istr(filename.c_str(), std::ios::in | std::ios::binary);
+    if (istr.fail()) {
+        error("DawgLexicon::addWordsFromFile: Couldn't open lexicon file " + filename);
+    }
+    istr.read((char*) &header, sizeof(header));
+    if (istr.fail() || memcmp(header.magic, NATIVE_MAGIC, sizeof(NATIVE_MAGIC)) != 0) {
+        return false;
+    }
+    bool swapped = header.byteOrder == BYTE_ORDER_SWAPPED;
+    if (swapped) {
+        header.version = my_ntohl(header.version);
+        header.startIndex = my_ntohl(header.startIndex);
+        header.numEdges = my_ntohl(header.numEdges);
+        header.numWords = my_ntohl(header.numWords);
+    } else if (header.byteOrder != BYTE_ORDER_MARK) {
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file " + filename);
+    }
+    if (header.version != NATIVE_VERSION) {
+        error("DawgLexicon::addWordsFromFile: Unsupported lexicon file version in " + filename);
+    }
+    if (header.numEdges > (1u << 24) || (header.numEdges > 0 && header.startIndex >= header.numEdges)) {
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file " + filename);
+    }
+    size_t fileSize = sizeof(header) + header.numEdges * sizeof(Edge);
+
+#ifndef _WIN32
+    if (!swapped && header.numEdges > 0) {
+        int fd = open(filename.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0 && (size_t) info.st_size >= fileSize) {
+            void* data = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (data != MAP_FAILED) {
+                mappedFile = data;
+                mappedSize = fileSize;
+                edges = (Edge*) ((char*) data + sizeof(header));
+                start = (header.numEdges == 0) ? NULL : &edges[header.startIndex];
+                numEdges = header.numEdges;
+                numDawgWords = header.numWords;
+                return true;
+            }
+        } else if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+
+    numEdges = header.numEdges;
+    edges = new Edge[numEdges];
+    istr.read((char*) edges, numEdges * sizeof(Edge));
+    if (istr.fail()) {
+        error("DawgLexicon::addWordsFromFile: Improperly formed lexicon file " + filename);
+    }
+    if (swapped) {
+        uint32_t* cur = (uint32_t*) edges;
+        for (int i = 0; i < numEdges; i++, cur++) {
+            *cur = my_ntohl(*cur);
+        }
+    }
+    start = (numEdges == 0) ? NULL : &edges[header.startIndex];
+    numDawgWords = header.numWords;
+    return true;
+}
+
+/*
+ * Implementation notes: writeBinaryFile
+ * -------------------------------------
+ * The edge array is written out exactly as it is held in memory, after a
+ * header that records the byte order of this machine.
+ */
+void DawgLexicon::writeBinaryFile(const std::string& filename) const {
+    if (!otherWords.isEmpty()) {
+        error("DawgLexicon::writeBinaryFile: words added with add() cannot be written");
+    }
+    NativeDawgHeader header;
+    memcpy(header.magic, NATIVE_MAGIC, sizeof(NATIVE_MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = NATIVE_VERSION;
+    header.startIndex = (start == NULL) ? 0 : (uint32_t) (start - edges);
+    header.numEdges = (start == NULL) ? 0 : numEdges;
+    header.numWords = (start == NULL) ? 0 : numDawgWords;
+    header.reserved = 0;
+    std::ofstream ostr(filename.c_str(), std::ios::out | std::ios::binary);
+    if (ostr.fail()) {
+        error("DawgLexicon::writeBinaryFile: Couldn't open lexicon file " + filename);
+    }
+    ostr.write((const char*) &header, sizeof(header));
+    ostr.write((const char*) edges, header.numEdges * sizeof(Edge));
+    ostr.close();
+    if (ostr.fail()) {
+        error("DawgLexicon::writeBinaryFile: Couldn't write lexicon file " + filename);
+    }
+}
+
+/*
+ * Frees the edge array, or unmaps it if it lives in a mapped file.
+ */
+void DawgLexicon::releaseEdges() {
+#ifndef _WIN32
+    if (mappedFile != NULL) {
+        munmap(mappedFile, mappedSize);
+        mappedFile = NULL;
+        mappedSize = 0;
+        edges = NULL;
+        return;
+    }
+#endif
+    if (edges != NULL) {
+        delete[] edges;
+        edges = NULL;
+    }
+}
+
 /*
  * Implementation notes: traceToLastEdge
  * -------------------------------------
@@ -332,9 +741,7 @@ DawgLexicon::Edge* DawgLexicon::traceToLastEdge(const std::string& s) const {
 
 DawgLexicon& DawgLexicon::operator =(const DawgLexicon& src) {
     if (this != &src) {
-        if (edges != NULL) {
-            delete[] edges;
-        }
+        releaseEdges();
         deepCopy(src);
     }
     return *this;
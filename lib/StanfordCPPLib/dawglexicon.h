@@ -4,6 +4,10 @@
  * This file exports the <code>DawgLexicon</code> class, which is a
  * compact structure for storing a list of words.
  * 
+ * @version 2026/10/18
+ * - added Cursor class for walking the DAWG one letter at a time
+ * - added native-endian binary format, memory-mapped on load; writeBinaryFile
+ * - added compile method, which builds a minimal DAWG from all the words
  * @version 2014/11/13
  * - added comparison operators <, >=, etc.
  * - added hashCode function
@@ -74,6 +78,14 @@ public:
      *<pre>
      *    DawgLexicon english("English.dat");
      *</pre>
+     *
+     * There are two binary formats.  The original one is stored big-endian
+     * and must be copied and byte-swapped when it is read.  The newer one,
+     * written by <code>writeBinaryFile</code>, is stored in the byte order
+     * of the machine that wrote it; on systems that support it, the file
+     * is mapped into memory read-only and searched where it lies, so
+     * loading takes no time and processes that load the same file share
+     * one copy of it.
      */
     DawgLexicon();
     DawgLexicon(const std::string& filename);
@@ -119,6 +131,21 @@ public:
      */
     bool contains(const std::string& word) const;
     
+    /*
+     * Method: compile
+     * Usage: lex.compile();
+     * ---------------------
+     * Rebuilds the DAWG so that it holds every word in the lexicon, including
+     * the words added with <code>add</code>, which are otherwise kept in a
+     * separate and much larger structure.  The new DAWG is minimal: no
+     * smaller automaton accepts the same words.  A lexicon built up from a
+     * word list and then compiled can be saved with
+     * <code>writeBinaryFile</code>.  Words that contain anything other than
+     * letters cannot be stored in a DAWG, so this method signals an error
+     * if there are any.  Compiling invalidates all cursors.
+     */
+    void compile();
+
     /*
      * Method: containsPrefix
      * Usage: if (lex.containsPrefix(prefix)) ...
@@ -129,6 +156,16 @@ public:
      */
     bool containsPrefix(const std::string& prefix) const;
     
+    /*
+     * Method: cursor
+     * Usage: DawgLexicon::Cursor cur = lex.cursor();
+     * ----------------------------------------------
+     * Returns a cursor positioned at the empty prefix of this lexicon.
+     * See the <code>DawgLexicon::Cursor</code> class below for details.
+     */
+    class Cursor;
+    Cursor cursor() const;
+
     /*
      * Method: equals
      * Usage: if (lex1.equals(lex2)) ...
@@ -182,6 +219,18 @@ public:
      * Returns an STL set object with the same elements as this lexicon.
      */
     std::set<std::string> toStlSet() const;
+
+    /*
+     * Method: writeBinaryFile
+     * Usage: lex.writeBinaryFile(filename);
+     * -------------------------------------
+     * Writes the DAWG to the given file in the native binary format, which
+     * any <code>DawgLexicon</code> or <code>Lexicon</code> constructor can
+     * read back.  Words added with <code>add</code> are kept apart from the
+     * DAWG and cannot be written, so this method signals an error if there
+     * are any.
+     */
+    void writeBinaryFile(const std::string& filename) const;
     
     /*
      * Operators: ==, !=
@@ -256,6 +305,8 @@ private:
     Edge* start;
     int numEdges;
     int numDawgWords;
+    void* mappedFile;       // memory-mapped file holding the edges, or NULL if
+    size_t mappedSize;      // the edges were allocated with new[]
     Set<std::string> otherWords;
 
 public:
@@ -273,6 +324,119 @@ public:
     DawgLexicon(const DawgLexicon& src);
     DawgLexicon& operator =(const DawgLexicon& src);
 
+    /*
+     * Class: DawgLexicon::Cursor
+     * --------------------------
+     * A cursor marks a prefix within the DAWG and can be extended one
+     * letter at a time, following a single edge per letter.  It offers
+     * the same operations as <code>Lexicon::Cursor</code>.
+     *
+     * Only the words read from a binary lexicon file are part of the DAWG;
+     * words added one at a time with <code>add</code> or read from a text
+     * file are not visible to cursors.  Cursors are small values that never
+     * allocate memory.  Any operation that modifies the lexicon invalidates
+     * all of its cursors.
+     */
+    class Cursor {
+    public:
+        /*
+         * Constructor: Cursor
+         * Usage: DawgLexicon::Cursor cur;
+         * -------------------------------
+         * Creates an invalid cursor that is not positioned in any lexicon.
+         */
+        Cursor() : m_lex(NULL), m_edge(NULL) {}
+
+        /*
+         * Method: descend
+         * Usage: DawgLexicon::Cursor next = cur.descend(letter);
+         * ------------------------------------------------------
+         * Returns a cursor for this prefix extended by the given letter.
+         * Case is ignored.  If no word in the DAWG begins with the extended
+         * prefix, the returned cursor is invalid.
+         */
+        Cursor descend(char letter) const {
+            if (letter >= 'A' && letter <= 'Z') {
+                letter += 'a' - 'A';
+            }
+            Edge* children = childEdges();
+            if (children == NULL || letter < 'a' || letter > 'z') {
+                return Cursor();
+            }
+            Edge* edge = m_lex->findEdgeForChar(children, letter);
+            return edge == NULL ? Cursor() : Cursor(m_lex, edge);
+        }
+
+        /*
+         * Method: childMask
+         * Usage: int mask = cur.childMask();
+         * ----------------------------------
+         * Returns a bit mask of the letters that can extend this prefix,
+         * with bit 0 standing for 'a' through bit 25 for 'z'.
+         */
+        int childMask() const {
+            int mask = 0;
+            Edge* edge = childEdges();
+            while (edge != NULL) {
+                mask |= 1 << (edge->letter - 1);
+                edge = edge->lastEdge ? NULL : edge + 1;
+            }
+            return mask;
+        }
+
+        /*
+         * Method: hasChildren
+         * Usage: if (cur.hasChildren()) ...
+         * ---------------------------------
+         * Returns <code>true</code> if some longer word begins with the
+         * prefix this cursor marks.
+         */
+        bool hasChildren() const {
+            return childEdges() != NULL;
+        }
+
+        /*
+         * Method: isValid
+         * Usage: if (cur.isValid()) ...
+         * -----------------------------
+         * Returns <code>true</code> if some word in the DAWG begins with
+         * the prefix this cursor marks.
+         */
+        bool isValid() const {
+            return m_lex != NULL;
+        }
+
+        /*
+         * Method: isWord
+         * Usage: if (cur.isWord()) ...
+         * ----------------------------
+         * Returns <code>true</code> if the prefix this cursor marks is
+         * itself a word in the DAWG.
+         */
+        bool isWord() const {
+            return m_edge != NULL && m_edge->accept;
+        }
+
+    private:
+        Cursor(const DawgLexicon* lex, Edge* edge) : m_lex(lex), m_edge(edge) {}
+
+        // first edge in the run of children below this prefix, or NULL
+        Edge* childEdges() const {
+            if (m_lex == NULL) {
+                return NULL;
+            } else if (m_edge == NULL) {
+                return m_lex->start;
+            } else {
+                return m_edge->children == 0 ? NULL : &m_lex->edges[m_edge->children];
+            }
+        }
+
+        const DawgLexicon* m_lex;   // NULL for an invalid cursor
+        Edge* m_edge;               // edge leading here; NULL for the empty prefix
+
+        friend class DawgLexicon;
+    };
+
     /*
      * Iterator support
      * ----------------
@@ -391,9 +555,14 @@ private:
     Edge* findEdgeForChar(Edge* children, char ch) const;
     Edge* traceToLastEdge(const std::string& s) const;
     void readBinaryFile(const std::string& filename);
+    bool readNativeBinaryFile(const std::string& filename);
+    void releaseEdges();
     void deepCopy(const DawgLexicon& src);
     int countDawgWords(Edge* start) const;
 
+    // Lexicon loads DAWG files by copying the edge array directly
+    friend class Lexicon;
+
     unsigned int charToOrd(char ch) const {
         return ((unsigned int)(tolower(ch) - 'a' + 1));
     }
@@ -0,0 +1,259 @@
+/*
+ * File: doublearraylexicon.cpp
+ * ----------------------------
+ * Implements the DoubleArrayLexicon class.  See doublearraylexicon.h for
+ * the interface and the layout of the arrays.
+ *
+ * The trie is built breadth-first from the cursors of a Lexicon, so the
+ * builder works the same whether that lexicon is a pointer trie, frozen, or
+ * loaded from a DAWG file.  Placing a prefix means choosing a base at which
+ * all of its child slots are still free; the search for one starts at the
+ * lowest free slot, which keeps the arrays densely packed.
+ *
+ * @version 2026/10/18
+ * - initial version
+ */
+
+#include "doublearraylexicon.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include "strlib.h"
+
+DoubleArrayLexicon::DoubleArrayLexicon() {
+    build(Lexicon());
+}
+
+DoubleArrayLexicon::DoubleArrayLexicon(const Lexicon& lexicon) {
+    build(lexicon);
+}
+
+DoubleArrayLexicon::DoubleArrayLexicon(const std::string& filename) {
+    Lexicon lexicon(filename);
+    build(lexicon);
+}
+
+bool DoubleArrayLexicon::contains(const std::string& word) const {
+    return contains(word.data(), word.length());
+}
+
+bool DoubleArrayLexicon::contains(const char* word, size_t length) const {
+    return length > 0 && trace(word, length).isWord();
+}
+
+bool DoubleArrayLexicon::containsPrefix(const std::string& prefix) const {
+    return containsPrefix(prefix.data(), prefix.length());
+}
+
+bool DoubleArrayLexicon::containsPrefix(const char* prefix, size_t length) const {
+    return length == 0 || trace(prefix, length).isValid();
+}
+
+DoubleArrayLexicon::Cursor DoubleArrayLexicon::cursor() const {
+    return isEmpty() ? Cursor() : Cursor(this, 0);
+}
+
+bool DoubleArrayLexicon::equals(const DoubleArrayLexicon& lex2) const {
+    if (this == &lex2) {
+        return true;
+    }
+    if (size() != lex2.size()) {
+        return false;
+    }
+    for (iterator it1 = begin(), it2 = lex2.begin(); it1 != end(); ++it1, ++it2) {
+        if (*it1 != *it2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DoubleArrayLexicon::isEmpty() const {
+    return m_size == 0;
+}
+
+int DoubleArrayLexicon::size() const {
+    return m_size;
+}
+
+std::string DoubleArrayLexicon::toString() const {
+    std::ostringstream out;
+    out << *this;
+    return out.str();
+}
+
+std::set<std::string> DoubleArrayLexicon::toStlSet() const {
+    std::set<std::string> result;
+    for (std::string word : *this) {
+        result.insert(word);
+    }
+    return result;
+}
+
+bool DoubleArrayLexicon::operator ==(const DoubleArrayLexicon& lex2) const {
+    return equals(lex2);
+}
+
+bool DoubleArrayLexicon::operator !=(const DoubleArrayLexicon& lex2) const {
+    return !equals(lex2);
+}
+
+/*
+ * Implementation notes: build
+ * ---------------------------
+ * Each prefix taken from the queue already has its own slot; placing it
+ * means finding a base for its children and claiming their slots, which
+ * gives the children slots of their own to be placed in turn.  Word ids are
+ * filled in afterwards by tracing the words in alphabetical order, so they
+ * come out as ranks no matter how the source lexicon numbered them.  That
+ * tracing starts from slot 0 rather than from cursor(), which treats the
+ * lexicon as empty until m_size has been counted up.
+ */
+void DoubleArrayLexicon::build(const Lexicon& lexicon) {
+    m_size = 0;
+    m_base.assign(1, 0);
+    m_check.assign(1, 0);
+    m_firstFree = 1;
+    if (lexicon.isEmpty()) {
+        return;
+    }
+
+    std::vector<std::pair<Lexicon::Cursor, int> > queue;
+    queue.push_back(std::make_pair(lexicon.cursor(), 0));
+    for (size_t i = 0; i < queue.size(); i++) {
+        Lexicon::Cursor cur = queue[i].first;
+        int state = queue[i].second;
+        int codes[NUM_CODES];
+        int numCodes = 0;
+        if (cur.isWord()) {
+            codes[numCodes++] = 0;
+        }
+        int mask = cur.childMask();
+        for (int code = 1; code < NUM_CODES; code++) {
+            if (mask & (1 << (code - 1))) {
+                codes[numCodes++] = code;
+            }
+        }
+        int base = findBase(codes, numCodes);
+        m_base[state] = base;
+        for (int k = 0; k < numCodes; k++) {
+            int next = base + codes[k];
+            m_check[next] = state;
+            if (codes[k] != 0) {
+                queue.push_back(std::make_pair(cur.descend((char) ('a' + codes[k] - 1)), next));
+            }
+        }
+    }
+
+    for (std::string word : lexicon) {
+        int state = 0;
+        for (size_t i = 0; i < word.length(); i++) {
+            state = transition(state, word[i] - 'a' + 1);
+        }
+        m_base[transition(state, 0)] = m_size++;
+    }
+
+    std::vector<int32_t>(m_base).swap(m_base);     // trim spare capacity
+    std::vector<int32_t>(m_check).swap(m_check);
+}
+
+/*
+ * Returns the lowest base at which every code in codes lands on a free
+ * slot, growing the arrays if needed.  The codes are in increasing order,
+ * so only bases that put the first code on a free slot are tried.
+ */
+int DoubleArrayLexicon::findBase(const int* codes, int numCodes) {
+    while (m_firstFree < (int) m_check.size() && m_check[m_firstFree] != -1) {
+        m_firstFree++;
+    }
+    for (int slot = std::max(m_firstFree, codes[0] + 1); ; slot++) {
+        growTo(slot + 1);
+        if (m_check[slot] != -1) {
+            continue;
+        }
+        int base = slot - codes[0];
+        growTo(base + codes[numCodes - 1] + 1);
+        bool fits = true;
+        for (int k = 1; k < numCodes && fits; k++) {
+            fits = m_check[base + codes[k]] == -1;
+        }
+        if (fits) {
+            return base;
+        }
+    }
+}
+
+void DoubleArrayLexicon::growTo(int size) {
+    if (size > (int) m_check.size()) {
+        m_base.resize(size, 0);
+        m_check.resize(size, -1);
+    }
+}
+
+DoubleArrayLexicon::Cursor DoubleArrayLexicon::trace(const char* letters, size_t length) const {
+    Cursor cur = cursor();
+    for (size_t i = 0; i < length && cur.isValid(); i++) {
+        cur = cur.descend(letters[i]);
+    }
+    return cur;
+}
+
+DoubleArrayLexicon::iterator::iterator(const DoubleArrayLexicon* lex, bool endFlag) {
+    m_lex = lex;
+    m_index = lex->size();
+    if (!endFlag && !lex->isEmpty()) {
+        m_path.push_back(0);
+        m_index = -1;
+        advance();
+    }
+}
+
+/*
+ * Implementation notes: iterator::advance
+ * ---------------------------------------
+ * A preorder walk of the trie, as in Lexicon::iterator: go down to the
+ * lowest child letter, or else back up to the nearest prefix with a later
+ * child letter, until reaching a word.
+ */
+void DoubleArrayLexicon::iterator::advance() {
+    int code = 1;
+    while (true) {
+        int next = -1;
+        while (code < NUM_CODES && (next = m_lex->transition(m_path.back(), code)) < 0) {
+            code++;
+        }
+        if (next < 0) {
+            if (m_word.empty()) {
+                m_index = m_lex->size();
+                return;
+            }
+            code = m_word[m_word.length() - 1] - 'a' + 2;
+            m_word.erase(m_word.length() - 1);
+            m_path.pop_back();
+            continue;
+        }
+        m_path.push_back(next);
+        m_word.push_back((char) ('a' + code - 1));
+        if (m_lex->transition(next, 0) >= 0) {
+            m_index++;
+            return;
+        }
+        code = 1;
+    }
+}
+
+std::ostream& operator <<(std::ostream& out, const DoubleArrayLexicon& lex) {
+    out << "{";
+    bool first = true;
+    for (std::string word : lex) {
+        if (first) {
+            first = false;
+        } else {
+            out << ", ";
+        }
+        writeGenericValue(out, word, true);
+    }
+    out << "}";
+    return out;
+}
@@ -0,0 +1,321 @@
+/*
+ * File: doublearraylexicon.h
+ * --------------------------
+ * This file exports the <code>DoubleArrayLexicon</code> class, a read-only
+ * word list stored as a double-array trie.
+ *
+ * @version 2026/10/18
+ * - initial version
+ */
+
+#ifndef _doublearraylexicon_h
+#define _doublearraylexicon_h
+
+#include <iterator>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "lexicon.h"
+
+/*
+ * Class: DoubleArrayLexicon
+ * -------------------------
+ * This class represents a fixed <b><i>lexicon,</i></b> or word list, with
+ * the same lookup operations as <code>Lexicon</code>.  It is built once,
+ * from a <code>Lexicon</code> or a lexicon file, and cannot be changed
+ * afterwards.
+ *
+ * <p>The words are kept in a double-array trie: every prefix is a number,
+ * and the prefix one letter longer is found by adding the letter's code to
+ * an entry of one array, the <i>base</i>, and confirming in a second array,
+ * the <i>check</i>, that the slot reached really belongs to the prefix.
+ * Each step of a search is therefore two array reads, whatever the letter
+ * and however many siblings it has, and the whole trie is two arrays of
+ * integers.
+ *
+ *<pre>
+ *    DoubleArrayLexicon english("EnglishWords.dat");
+ *    if (english.contains("zebra")) ...
+ *</pre>
+ */
+
+class DoubleArrayLexicon {
+public:
+    /*
+     * Constructor: DoubleArrayLexicon
+     * Usage: DoubleArrayLexicon lex;
+     *        DoubleArrayLexicon lex(lexicon);
+     *        DoubleArrayLexicon lex(filename);
+     * ----------------------------------------
+     * Builds a lexicon holding the same words as the given
+     * <code>Lexicon</code>, or as the given lexicon file, which may be in
+     * any format the <code>Lexicon</code> constructor accepts.  The
+     * default constructor creates an empty lexicon.
+     */
+    DoubleArrayLexicon();
+    DoubleArrayLexicon(const Lexicon& lexicon);
+    DoubleArrayLexicon(const std::string& filename);
+
+    /*
+     * Method: contains
+     * Usage: if (lex.contains(word)) ...
+     * ----------------------------------
+     * Returns <code>true</code> if <code>word</code> is contained in the
+     * lexicon.  Case is ignored, as in <code>Lexicon</code>.
+     */
+    bool contains(const std::string& word) const;
+    bool contains(const char* word, size_t length) const;
+
+    /*
+     * Method: containsPrefix
+     * Usage: if (lex.containsPrefix(prefix)) ...
+     * ------------------------------------------
+     * Returns <code>true</code> if any words in the lexicon begin with
+     * <code>prefix</code>.  The empty string is a prefix of every string.
+     */
+    bool containsPrefix(const std::string& prefix) const;
+    bool containsPrefix(const char* prefix, size_t length) const;
+
+    /*
+     * Method: cursor
+     * Usage: DoubleArrayLexicon::Cursor cur = lex.cursor();
+     * -----------------------------------------------------
+     * Returns a cursor positioned at the empty prefix of this lexicon.
+     * See the <code>DoubleArrayLexicon::Cursor</code> class below.
+     */
+    class Cursor;
+    Cursor cursor() const;
+
+    /*
+     * Method: equals
+     * Usage: if (lex1.equals(lex2)) ...
+     * ---------------------------------
+     * Returns <code>true</code> if the two lexicons contain the same words.
+     */
+    bool equals(const DoubleArrayLexicon& lex2) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (lex.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if the lexicon contains no words.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: size
+     * Usage: int n = lex.size();
+     * --------------------------
+     * Returns the number of words contained in the lexicon.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = lex.toString();
+     * -----------------------------------
+     * Converts the lexicon to a printable string representation.
+     */
+    std::string toString() const;
+
+    /*
+     * Returns an STL set object with the same elements as this lexicon.
+     */
+    std::set<std::string> toStlSet() const;
+
+    /*
+     * Operators: ==, !=
+     * Usage: if (lex1 == lex2) ...
+     * ----------------------------
+     * Relational operators to compare two lexicons to see if they have the same elements.
+     */
+    bool operator ==(const DoubleArrayLexicon& lex2) const;
+    bool operator !=(const DoubleArrayLexicon& lex2) const;
+
+    /*
+     * Additional DoubleArrayLexicon operations
+     * ----------------------------------------
+     * The DoubleArrayLexicon class can be copied and assigned, and its words
+     * can be visited in alphabetical order with the range-based for
+     * statement and STL iterators.
+     */
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+private:
+    /*
+     * Slot s of the arrays is the prefix with number s; the root is slot 0.
+     * The child of s for the letter with code c (1 for 'a' through 26 for
+     * 'z') is slot m_base[s] + c, provided m_check of that slot is s.  If
+     * s is a word, slot m_base[s] + 0 is also checked to s, and its own
+     * base entry holds the word's id.  Unused slots have a check of -1.
+     */
+    static const int NUM_CODES = 27;    // the end-of-word code 0 and 26 letters
+
+    int transition(int state, int code) const {
+        int next = m_base[state] + code;
+        return (next < (int) m_check.size() && m_check[next] == state) ? next : -1;
+    }
+
+    int wordId(int state) const {
+        int end = transition(state, 0);
+        return end < 0 ? -1 : m_base[end];
+    }
+
+    void build(const Lexicon& lexicon);
+    int findBase(const int* codes, int numCodes);
+    void growTo(int size);
+    Cursor trace(const char* letters, size_t length) const;
+
+    /* instance variables */
+    std::vector<int32_t> m_base;
+    std::vector<int32_t> m_check;
+    int m_firstFree;                    // no free slot lies below this; used only while building
+    int m_size;
+
+public:
+    /*
+     * Class: DoubleArrayLexicon::Cursor
+     * ---------------------------------
+     * A cursor marks a prefix within the lexicon and can be extended one
+     * letter at a time, exactly like <code>Lexicon::Cursor</code>.  Word
+     * ids run from 0 to size() - 1 in alphabetical order.
+     */
+    class Cursor {
+    public:
+        Cursor() : m_lex(NULL), m_state(-1) {}
+
+        /*
+         * Method: descend
+         * Usage: DoubleArrayLexicon::Cursor next = cur.descend(letter);
+         * -------------------------------------------------------------
+         * Returns a cursor for this prefix extended by the given letter, or
+         * an invalid cursor if no word begins with the longer prefix.
+         */
+        Cursor descend(char letter) const {
+            if (letter >= 'A' && letter <= 'Z') {
+                letter += 'a' - 'A';
+            }
+            if (m_state < 0 || letter < 'a' || letter > 'z') {
+                return Cursor();
+            }
+            return Cursor(m_lex, m_lex->transition(m_state, letter - 'a' + 1));
+        }
+
+        /*
+         * Methods: childMask, hasChildren, isValid, isWord, nodeKey, wordId
+         * -----------------------------------------------------------------
+         * These methods behave as they do in <code>Lexicon::Cursor</code>.
+         */
+        int childMask() const {
+            int mask = 0;
+            if (m_state >= 0) {
+                for (int code = 1; code < NUM_CODES; code++) {
+                    if (m_lex->transition(m_state, code) >= 0) {
+                        mask |= 1 << (code - 1);
+                    }
+                }
+            }
+            return mask;
+        }
+
+        bool hasChildren() const {
+            return childMask() != 0;
+        }
+
+        bool isValid() const {
+            return m_state >= 0;
+        }
+
+        bool isWord() const {
+            return m_state >= 0 && m_lex->transition(m_state, 0) >= 0;
+        }
+
+        uint64_t nodeKey() const {
+            return (uint64_t) (m_state + 1);
+        }
+
+        int wordId() const {
+            return m_state < 0 ? -1 : m_lex->wordId(m_state);
+        }
+
+    private:
+        Cursor(const DoubleArrayLexicon* lex, int state)
+            : m_lex(state < 0 ? NULL : lex), m_state(state) {}
+
+        const DoubleArrayLexicon* m_lex;
+        int m_state;                    // slot of this prefix, or -1 if invalid
+
+        friend class DoubleArrayLexicon;
+    };
+
+    /*
+     * Iterator support
+     * ----------------
+     * The iterator walks the trie in alphabetical order, keeping the path
+     * from the root to the current word.
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, std::string> {
+    public:
+        iterator() : m_lex(NULL), m_index(0) {
+            /* empty */
+        }
+
+        iterator(const DoubleArrayLexicon* lex, bool endFlag);
+
+        iterator& operator ++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            advance();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) const {
+            return m_lex == rhs.m_lex && m_index == rhs.m_index;
+        }
+
+        bool operator !=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        const std::string& operator *() const {
+            return m_word;
+        }
+
+        const std::string* operator ->() const {
+            return &m_word;
+        }
+
+    private:
+        void advance();
+
+        const DoubleArrayLexicon* m_lex;
+        int m_index;                    // number of words before m_word; size() at the end
+        std::string m_word;             // the current word
+        std::vector<int> m_path;        // m_path[i] is the slot of the first i letters
+    };
+
+    iterator begin() const {
+        return iterator(this, false);
+    }
+
+    iterator end() const {
+        return iterator(this, true);
+    }
+};
+
+/*
+ * Prints the lexicon to the given output stream.
+ */
+std::ostream& operator <<(std::ostream& os, const DoubleArrayLexicon& lex);
+
+#endif
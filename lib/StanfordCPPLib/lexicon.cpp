@@ -15,6 +15,21 @@
  *
  * The original DAWG implementation is retained as dawglexicon.h/cpp.
  * 
+ * @version 2026/10/18
+ * - added cursor method and Lexicon::Cursor class
+ * - added Cursor childMask and hasChildren methods
+ * - added word ids stored in the trie nodes, wordIdLimit method
+ * - added freeze method and the frozen FlatNode layout
+ * - readBinaryFile copies the DAWG's edges into the frozen layout
+ * - removed m_allWords; iteration, equals, toStlSet and << walk the trie
+ * - contains and containsPrefix walk the trie in place without copying
+ * - added parallel addWordsFromFile with a progress function
+ * - added saveSnapshot and loadSnapshot
+ * - trie nodes come from a block arena; clear frees the blocks at once
+ * - add, remove and thaw helpers walk the trie iteratively, without substr
+ * - copying an unfrozen lexicon copies its nodes, so word ids are kept
+ * - BUGFIX: remove no longer deletes a leaf prefix that is not a word, or
+ *   drops a word without counting it; emptied prefixes are pruned
  * @version 2014/11/13
  * - added comparison operators <, >=, etc.
  * - added hashCode function
@@ -24,36 +39,66 @@
  */
 
 #include "lexicon.h"
+#include <algorithm>
 #include <cctype>
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
 #include <string>
+#include <thread>
 #include "compare.h"
 #include "dawglexicon.h"
 #include "error.h"
 #include "hashcode.h"
 #include "strlib.h"
+#include "timer.h"
+
+/*
+ * Header of a snapshot file.  The frozen nodes follow it directly, in the
+ * byte order of the machine that wrote the file.
+ */
+struct SnapshotHeader {
+    char magic[8];          // SNAPSHOT_MAGIC
+    uint32_t byteOrder;     // BYTE_ORDER_MARK as written
+    uint32_t version;       // SNAPSHOT_VERSION
+    uint32_t numNodes;
+    uint32_t numWords;
+    uint32_t checksum;      // snapshotChecksum of the counts and the nodes
+    uint32_t reserved;      // 0
+};
+
+static const char SNAPSHOT_MAGIC[8] = { 'L', 'E', 'X', 'S', 'N', 'A', 'P', '\0' };
+static const uint32_t SNAPSHOT_VERSION = 2;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
 
 static bool isDAWGFile(const std::string& filename);
+static void parseWords(const std::string& text, size_t start, size_t end,
+                       std::vector<std::string>& words);
+static void runThreads(int numThreads, const std::function<void(int)>& fn);
 static bool scrub(std::string& str);
+static uint32_t snapshotChecksum(const SnapshotHeader& header, const void* nodes,
+                                 size_t numBytes);
 
 Lexicon::Lexicon() {
     m_root = NULL;
     m_size = 0;
+    m_wordIdLimit = 0;
 }
 
 Lexicon::Lexicon(const std::string& filename) {
     m_root = NULL;
     m_size = 0;
+    m_wordIdLimit = 0;
     addWordsFromFile(filename);
 }
 
 Lexicon::Lexicon(const Lexicon& src) {
     m_root = NULL;
     m_size = 0;
+    m_wordIdLimit = 0;
     deepCopy(src);
 }
 
@@ -69,7 +114,8 @@ bool Lexicon::add(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return addHelper(m_root, scrubbed, /* originalWord */ scrubbed);
+    thaw();
+    return addHelper(m_root, scrubbed);
 }
 
 void Lexicon::addWordsFromFile(const std::string& filename) {
@@ -88,33 +134,200 @@ void Lexicon::addWordsFromFile(const std::string& filename) {
     }
 }
 
+/*
+ * Implementation notes: addWordsFromFile
+ * --------------------------------------
+ * The parallel load runs in four stages, each one timed for the progress
+ * function:
+ *
+ * - read:  the whole file is read into one string, in a single block if
+ *          its size is known and in pieces if it is a pipe.
+ * - parse: the string is cut into one piece per thread at line breaks, and
+ *          each thread trims and scrubs the lines of its piece, exactly as
+ *          add(trim(line)) would, then sorts its words and drops repeats.
+ * - merge: the alphabet is divided into one range of first letters per
+ *          thread, with about the same number of words in each, and each
+ *          thread merges its letters' part of every sorted run.
+ * - build: if the lexicon was empty, each thread builds the subtries under
+ *          the root for its letters.  The words arrive in alphabetical
+ *          order, so numbering them by position gives the same ids freeze
+ *          would.  Otherwise the merged words are added one at a time.
+ */
+void Lexicon::addWordsFromFile(const std::string& filename, int numThreads,
+                               const std::function<void(const LoadProgress&)>& progress) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    Timer timer(true);
+    auto report = [&](const std::string& stage, int numWords) {
+        long elapsedMS = timer.stop();
+        if (progress) {
+            LoadProgress info = { stage, elapsedMS, numWords };
+            progress(info);
+        }
+        timer.start();
+    };
+
+    // the file is opened only once, so that a pipe loses none of its text
+    std::ifstream istr(filename.c_str(), std::ios::in | std::ios::binary);
+    if (istr.fail()) {
+        error("Lexicon::addWordsFromFile: Couldn't open lexicon file " + filename);
+    }
+    char firstFour[4];
+    istr.read(firstFour, sizeof(firstFour));
+    std::string text(firstFour, (size_t) istr.gcount());
+    if (text == "DAWG") {
+        istr.close();
+        readBinaryFile(filename);
+        report("read", size());
+        return;
+    }
+    istr.clear();
+    istr.seekg(0, std::ios::end);
+    std::streamoff fileSize = istr.tellg();
+    if (fileSize >= 0) {
+        text.resize((size_t) fileSize);
+        istr.seekg(0);
+        istr.read(&text[0], text.size());
+        text.resize((size_t) istr.gcount());
+    } else {
+        // a pipe or other stream that cannot seek is read in pieces to the end
+        istr.clear();
+        char buffer[1 << 16];
+        while (istr.read(buffer, sizeof(buffer)) || istr.gcount() > 0) {
+            text.append(buffer, (size_t) istr.gcount());
+        }
+    }
+    istr.close();
+    report("read", 0);
+
+    std::vector<size_t> bounds(numThreads + 1, text.size());
+    bounds[0] = 0;
+    for (int t = 1; t < numThreads; t++) {
+        size_t pos = std::max(bounds[t - 1], text.size() / numThreads * t);
+        pos = text.find('\n', pos);
+        bounds[t] = (pos == std::string::npos) ? text.size() : pos + 1;
+    }
+    std::vector<std::vector<std::string> > runs(numThreads);
+    runThreads(numThreads, [&](int t) {
+        std::vector<std::string>& run = runs[t];
+        parseWords(text, bounds[t], bounds[t + 1], run);
+        std::sort(run.begin(), run.end());
+        run.erase(std::unique(run.begin(), run.end()), run.end());
+    });
+    std::string().swap(text);
+    int numParsed = 0;
+    for (int t = 0; t < numThreads; t++) {
+        numParsed += (int) runs[t].size();
+    }
+    report("parse", numParsed);
+
+    // letterStarts[t][c] is where words beginning with 'a' + c start in run t
+    std::vector<std::vector<size_t> > letterStarts(numThreads, std::vector<size_t>(27));
+    std::vector<size_t> letterTotals(26, 0);
+    for (int t = 0; t < numThreads; t++) {
+        for (int c = 0; c <= 26; c++) {
+            letterStarts[t][c] = std::lower_bound(runs[t].begin(), runs[t].end(),
+                                                  std::string(1, (char) ('a' + c))) - runs[t].begin();
+        }
+        for (int c = 0; c < 26; c++) {
+            letterTotals[c] += letterStarts[t][c + 1] - letterStarts[t][c];
+        }
+    }
+    std::vector<int> firstLetters(numThreads + 1, 26);
+    firstLetters[0] = 0;
+    size_t assigned = 0;
+    int part = 1;
+    for (int c = 0; c < 26 && part < numThreads; c++) {
+        assigned += letterTotals[c];
+        if (assigned * numThreads >= (size_t) numParsed * part) {
+            firstLetters[part++] = c + 1;
+        }
+    }
+    std::vector<std::vector<std::string> > merged(numThreads);
+    runThreads(numThreads, [&](int p) {
+        std::vector<std::string>& words = merged[p];
+        for (int t = 0; t < numThreads; t++) {
+            size_t middle = words.size();
+            words.insert(words.end(),
+                         std::make_move_iterator(runs[t].begin() + letterStarts[t][firstLetters[p]]),
+                         std::make_move_iterator(runs[t].begin() + letterStarts[t][firstLetters[p + 1]]));
+            std::inplace_merge(words.begin(), words.begin() + middle, words.end());
+        }
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+    });
+    runs.clear();
+    int numMerged = 0;
+    for (int p = 0; p < numThreads; p++) {
+        numMerged += (int) merged[p].size();
+    }
+    report("merge", numMerged);
+
+    if (isEmpty()) {
+        thaw();
+        m_arena.clear();
+        m_root = m_arena.allocate();
+        std::vector<int> firstIds(numThreads, 0);
+        for (int p = 1; p < numThreads; p++) {
+            firstIds[p] = firstIds[p - 1] + (int) merged[p - 1].size();
+        }
+        std::vector<NodeArena> arenas(numThreads);
+        runThreads(numThreads, [&](int p) {
+            addSortedWords(arenas[p], m_root, merged[p], firstIds[p]);
+        });
+        for (int p = 0; p < numThreads; p++) {
+            m_arena.absorb(arenas[p]);
+        }
+        m_size = m_wordIdLimit = numMerged;
+        if (m_size == 0) {
+            m_arena.clear();
+            m_root = NULL;
+        }
+    } else {
+        for (int p = 0; p < numThreads; p++) {
+            for (const std::string& word : merged[p]) {
+                add(word);
+            }
+        }
+    }
+    report("build", size());
+}
+
 void Lexicon::clear() {
     m_size = 0;
-    m_allWords.clear();
-    deleteTree(m_root);
+    m_wordIdLimit = 0;
+    m_flatNodes.clear();
+    m_arena.clear();
     m_root = NULL;
 }
 
 bool Lexicon::contains(const std::string& word) const {
-    if (word.empty()) {
-        return false;
-    }
-    std::string scrubbed = word;
-    if (!scrub(scrubbed)) {
+    return contains(word.data(), word.length());
+}
+
+bool Lexicon::contains(const char* word, size_t length) const {
+    if (length == 0) {
         return false;
     }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ false);
+    return trace(word, length).isWord();
 }
 
 bool Lexicon::containsPrefix(const std::string& prefix) const {
-    if (prefix.empty()) {
+    return containsPrefix(prefix.data(), prefix.length());
+}
+
+bool Lexicon::containsPrefix(const char* prefix, size_t length) const {
+    if (length == 0) {
         return true;
     }
-    std::string scrubbed = prefix;
-    if (!scrub(scrubbed)) {
-        return false;
+    return trace(prefix, length).isValid();
+}
+
+Lexicon::Cursor Lexicon::cursor() const {
+    if (isFrozen()) {
+        return isEmpty() ? Cursor() : Cursor(&m_flatNodes[0], 0, 0);
     }
-    return containsHelper(m_root, scrubbed, /* isPrefix */ true);
+    return Cursor(m_root);
 }
 
 bool Lexicon::equals(const Lexicon& lex2) const {
@@ -125,21 +338,137 @@ bool Lexicon::equals(const Lexicon& lex2) const {
     if (size() != lex2.size()) {
         return false;
     }
-    return m_allWords == lex2.m_allWords;
+    for (iterator it1 = begin(), it2 = lex2.begin(); it1 != end(); ++it1, ++it2) {
+        if (*it1 != *it2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Implementation notes: freeze
+ * ----------------------------
+ * The nodes are numbered in breadth-first order, which places the children
+ * of every node in one run and keeps the short prefixes that every search
+ * passes through together at the front of the array.  Walking the numbered
+ * nodes backwards visits every child before its parent, so a second pass
+ * can total the words under each node, and a third turns the totals into
+ * each node's count of words under its earlier siblings.
+ */
+void Lexicon::freeze() {
+    if (isFrozen()) {
+        return;
+    }
+    std::vector<TrieNode*> order;
+    order.push_back(m_root);
+    m_flatNodes.resize(1);
+    for (size_t i = 0; i < order.size(); i++) {
+        TrieNode* node = order[i];
+        uint32_t bits = 0;
+        uint32_t firstChild = (uint32_t) order.size();
+        if (node != NULL) {
+            if (node->isWord()) {
+                bits |= WORD_BIT;
+            }
+            for (char letter = 'a'; letter <= 'z'; letter++) {
+                TrieNode* child = node->child(letter);
+                if (child != NULL) {
+                    bits |= uint32_t(1) << (letter - 'a');
+                    order.push_back(child);
+                }
+            }
+        }
+        m_flatNodes[i].bits = bits;
+        m_flatNodes[i].firstChild = firstChild;
+        m_flatNodes[i].wordsBefore = 0;
+        m_flatNodes.resize(order.size());
+    }
+
+    std::vector<uint32_t> wordCounts(m_flatNodes.size());
+    for (size_t i = m_flatNodes.size(); i-- > 0; ) {
+        const FlatNode& node = m_flatNodes[i];
+        uint32_t count = (node.bits & WORD_BIT) ? 1 : 0;
+        int numChildren = countBits(node.bits & LETTER_BITS);
+        for (int k = 0; k < numChildren; k++) {
+            count += wordCounts[node.firstChild + k];
+        }
+        wordCounts[i] = count;
+    }
+    for (size_t i = 0; i < m_flatNodes.size(); i++) {
+        const FlatNode& node = m_flatNodes[i];
+        int numChildren = countBits(node.bits & LETTER_BITS);
+        uint32_t before = 0;
+        for (int k = 0; k < numChildren; k++) {
+            m_flatNodes[node.firstChild + k].wordsBefore = before;
+            before += wordCounts[node.firstChild + k];
+        }
+    }
+
+    std::vector<FlatNode>(m_flatNodes).swap(m_flatNodes);   // trim spare capacity
+    m_arena.clear();
+    m_root = NULL;
+    m_wordIdLimit = m_size;
 }
 
 bool Lexicon::isEmpty() const {
     return size() == 0;
 }
 
+bool Lexicon::isFrozen() const {
+    return !m_flatNodes.empty();
+}
+
+/*
+ * Implementation notes: loadSnapshot
+ * ----------------------------------
+ * The header is checked before anything is read into the lexicon, and the
+ * nodes and the counts in the header are checked against the checksum
+ * before the lexicon takes them over, so a bad file leaves the lexicon as
+ * it was.
+ */
+void Lexicon::loadSnapshot(const std::string& filename) {
+    std::ifstream istr(filename.c_str(), std::ios::in | std::ios::binary);
+    if (istr.fail()) {
+        error("Lexicon::loadSnapshot: Couldn't open snapshot file " + filename);
+    }
+    SnapshotHeader header;
+    istr.read((char*) &header, sizeof(header));
+    if (istr.fail() || memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        error("Lexicon::loadSnapshot: " + filename + " is not a lexicon snapshot");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        error("Lexicon::loadSnapshot: " + filename
+              + " was written on a machine of the other byte order");
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        error("Lexicon::loadSnapshot: Unsupported snapshot version in " + filename);
+    }
+    if (header.numNodes > (1u << 28)) {
+        error("Lexicon::loadSnapshot: Improperly formed snapshot file " + filename);
+    }
+    std::vector<FlatNode> nodes(header.numNodes);
+    if (!nodes.empty()) {
+        istr.read((char*) &nodes[0], nodes.size() * sizeof(FlatNode));
+    }
+    if (istr.fail()
+            || snapshotChecksum(header, nodes.data(), nodes.size() * sizeof(FlatNode))
+               != header.checksum) {
+        error("Lexicon::loadSnapshot: Improperly formed snapshot file " + filename);
+    }
+    clear();
+    m_flatNodes.swap(nodes);
+    m_size = m_wordIdLimit = (int) header.numWords;
+}
+
 void Lexicon::mapAll(void (*fn)(std::string)) const {
-    for (std::string word : m_allWords) {
+    for (std::string word : *this) {
         fn(word);
     }
 }
 
 void Lexicon::mapAll(void (*fn)(const std::string&)) const {
-    for (std::string word : m_allWords) {
+    for (std::string word : *this) {
         fn(word);
     }
 }
@@ -152,7 +481,8 @@ bool Lexicon::remove(const std::string& word) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ false);
+    thaw();
+    return removeHelper(m_root, scrubbed, /* isPrefix */ false);
 }
 
 bool Lexicon::removePrefix(const std::string& prefix) {
@@ -165,14 +495,46 @@ bool Lexicon::removePrefix(const std::string& prefix) {
     if (!scrub(scrubbed)) {
         return false;
     }
-    
-    return removeHelper(m_root, scrubbed, /* originalWord */ scrubbed, /* isPrefix */ true);
+    thaw();
+    return removeHelper(m_root, scrubbed, /* isPrefix */ true);
+}
+
+void Lexicon::saveSnapshot(const std::string& filename) const {
+    if (!isFrozen() && !isEmpty()) {
+        Lexicon frozen(*this);
+        frozen.freeze();
+        frozen.saveSnapshot(filename);
+        return;
+    }
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = SNAPSHOT_VERSION;
+    header.numNodes = (uint32_t) m_flatNodes.size();
+    header.numWords = (uint32_t) m_size;
+    header.checksum = snapshotChecksum(header, m_flatNodes.data(),
+                                       m_flatNodes.size() * sizeof(FlatNode));
+    header.reserved = 0;
+    std::ofstream ostr(filename.c_str(), std::ios::out | std::ios::binary);
+    if (ostr.fail()) {
+        error("Lexicon::saveSnapshot: Couldn't open snapshot file " + filename);
+    }
+    ostr.write((const char*) &header, sizeof(header));
+    ostr.write((const char*) m_flatNodes.data(), m_flatNodes.size() * sizeof(FlatNode));
+    ostr.close();
+    if (ostr.fail()) {
+        error("Lexicon::saveSnapshot: Couldn't write snapshot file " + filename);
+    }
 }
 
 int Lexicon::size() const {
     return m_size;
 }
 
+int Lexicon::wordIdLimit() const {
+    return m_wordIdLimit;
+}
+
 std::string Lexicon::toString() const {
     std::ostringstream out;
     out << *this;
@@ -181,7 +543,7 @@ std::string Lexicon::toString() const {
 
 std::set<std::string> Lexicon::toStlSet() const {
     std::set<std::string> result;
-    for (std::string word : m_allWords) {
+    for (std::string word : *this) {
         result.insert(word);
     }
     return result;
@@ -216,119 +578,356 @@ bool Lexicon::operator >=(const Lexicon& lex2) const {
 
 /* private helpers implementation */
 
+/*
+ * Implementation notes: addHelper
+ * -------------------------------
+ * Walks down from node one letter at a time, creating any nodes that are
+ * missing, and marks the last one as a word.  link always points at the
+ * child pointer being followed, so a new node can be hooked in place.
+ */
 // pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::addHelper(TrieNode*& node, const std::string& word, const std::string& originalWord) {
-    if (node == NULL) {
-        // create nodes all the way down, one for each letter of the word
-        node = new TrieNode();
+bool Lexicon::addHelper(TrieNode*& node, const std::string& word) {
+    TrieNode** link = &node;
+    for (size_t i = 0; ; i++) {
+        if (*link == NULL) {
+            *link = m_arena.allocate();
+        }
+        if (i == word.length()) {
+            break;
+        }
+        link = &(*link)->child(word[i]);
     }
+    if ((*link)->isWord()) {
+        return false;   // duplicate word; already present
+    }
+    (*link)->setWordId(m_wordIdLimit++);
+    m_size++;
+    return true;
+}
 
-    if (word.empty()) {
-        // base case: we have added all of the letters of this word
-        if (node->isWord()) {
-            return false;   // duplicate word; already present
-        } else {
-            // new word; add it
-            node->setWord(true);
-            m_size++;
-            m_allWords.add(originalWord);
-            return true;
+/*
+ * Adds the given words below root, numbering them from firstId in order.
+ * The words must be scrubbed and not yet in the trie.  Nothing but the
+ * subtries for the words' first letters is touched, which is what lets
+ * threads with different first letters share the root.
+ */
+void Lexicon::addSortedWords(NodeArena& arena, TrieNode* root,
+                              const std::vector<std::string>& words, int firstId) {
+    for (size_t i = 0; i < words.size(); i++) {
+        TrieNode* node = root;
+        for (char letter : words[i]) {
+            TrieNode*& child = node->child(letter);
+            if (child == NULL) {
+                child = arena.allocate();
+            }
+            node = child;
         }
-    } else {
-        // recursive case: chop off first letter, traverse the rest
-        return addHelper(node->child(word[0]), word.substr(1), originalWord);
+        node->setWordId(firstId + (int) i);
     }
 }
 
+/*
+ * Implementation notes: removeHelper
+ * ----------------------------------
+ * Walks down from node, remembering the child pointer followed at every
+ * level, to the node for word.  For a prefix, that node's whole subtree
+ * goes; for a word, the node just stops being a word.  Either way, nodes
+ * left with no word and no children are then released on the way back up,
+ * so that no prefix lingers without a word below it.
+ */
 // pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const {
-    if (node == NULL) {
-        // base case: no pointer down to here, so prefix must not exist
-        return false;
-    } else if (word.length() == 0) {
-        // base case: Found nodes all the way down.
-        // If we are looking for a prefix, this means this path IS a prefix,
-        // so we should return true.
-        // If we are looking for an exact word match rather than a prefix,
-        // we must check the isWord flag to see that this word was added
-        return (isPrefix ? true : node->isWord());
-    } else {
-        // recursive case: follow appropriate child pointer for one letter
-        return containsHelper(node->child(word[0]), word.substr(1), isPrefix);
+bool Lexicon::removeHelper(TrieNode*& node, const std::string& word, bool isPrefix) {
+    std::vector<TrieNode**> path;
+    path.reserve(word.length() + 1);
+    TrieNode** link = &node;
+    for (size_t i = 0; *link != NULL; i++) {
+        path.push_back(link);
+        if (i == word.length()) {
+            break;
+        }
+        link = &(*link)->child(word[i]);
+    }
+    if (*link == NULL) {
+        return false;   // this word/prefix is not contained
     }
-}
 
-// pre: word is scrubbed to contain only lowercase a-z letters
-bool Lexicon::removeHelper(TrieNode*& node, const std::string& word, const std::string& originalWord, bool isPrefix) {
-    if (node == NULL) {
-        // base case: dead end; this word/prefix must not be contained
-        return false;
-    } else if (word.empty()) {
-        // base case: we have walked all of the letters of this word/prefix
-        // and now we must do the removal
-        if (isPrefix) {
-            // remove this node and all of its descendents
-            removeSubtreeHelper(node, originalWord);   // removes from m_allWords, sets m_size
-            node = NULL;
-        } else {
-            // remove / de-word-ify this node only
-            if (node->isLeaf()) {
-                delete node;
-                node = NULL;
-            } else {
-                if (node->isWord()) {
-                    node->setWord(false);
-                    m_allWords.remove(originalWord);
-                    m_size--;
-                }
+    int oldSize = m_size;
+    if (isPrefix) {
+        removeSubtreeHelper(*link);   // sets m_size
+    } else if ((*link)->isWord()) {
+        (*link)->setWordId(-1);
+        m_size--;
+    }
+    while (!path.empty()) {
+        TrieNode*& last = *path.back();
+        if (last != NULL) {
+            if (last->isWord() || !last->isLeaf()) {
+                break;
             }
+            m_arena.release(last);
+            last = NULL;
         }
-        return true;
-    } else {
-        // recursive case: chop off first letter, traverse the rest
-        return removeHelper(node->child(word[0]), word.substr(1), originalWord, isPrefix);
+        path.pop_back();
     }
+    return m_size != oldSize;
 }
 
-// remove/free this node and all descendents
-void Lexicon::removeSubtreeHelper(TrieNode*& node, const std::string& originalWord) {
+/*
+ * Releases node and all of its descendants, counting off the words among
+ * them, with an explicit stack in place of recursion.
+ */
+void Lexicon::removeSubtreeHelper(TrieNode*& node) {
+    std::vector<TrieNode*> stack;
     if (node != NULL) {
+        stack.push_back(node);
+    }
+    while (!stack.empty()) {
+        TrieNode* top = stack.back();
+        stack.pop_back();
         for (char letter = 'a'; letter <= 'z'; letter++) {
-            removeSubtreeHelper(node->child(letter), originalWord + letter);
+            if (top->child(letter) != NULL) {
+                stack.push_back(top->child(letter));
+            }
         }
-        if (node->isWord()) {
-            m_allWords.remove(originalWord);
+        if (top->isWord()) {
             m_size--;
         }
-        delete node;
-        node = NULL;
+        m_arena.release(top);
     }
+    node = NULL;
 }
 
+/*
+ * Implementation notes: deepCopy
+ * ------------------------------
+ * A frozen lexicon has no pointers in it, so it copies as a block.  A
+ * pointer trie is copied node by node rather than by adding its words
+ * again, so that every word keeps its id; FoundWords and the solvers rely
+ * on the ids of a copy matching those of the original.  The nodes still to
+ * be copied wait on an explicit stack, as in thawHelper.
+ */
 void Lexicon::deepCopy(const Lexicon& src) {
-    for (std::string word : src.m_allWords) {
-        add(word);
+    m_size = src.m_size;
+    m_wordIdLimit = src.m_wordIdLimit;
+    if (src.isFrozen()) {
+        m_flatNodes = src.m_flatNodes;
+        return;
+    }
+    if (src.m_root == NULL) {
+        return;
+    }
+    struct Pending {
+        TrieNode** link;
+        TrieNode* source;
+    };
+    std::vector<Pending> stack;
+    Pending first = { &m_root, src.m_root };
+    stack.push_back(first);
+    while (!stack.empty()) {
+        Pending top = stack.back();
+        stack.pop_back();
+        TrieNode* created = m_arena.allocate();
+        *top.link = created;
+        created->setWordId(top.source->wordId());
+        for (char letter = 'a'; letter <= 'z'; letter++) {
+            if (top.source->child(letter) != NULL) {
+                Pending next = { &created->child(letter), top.source->child(letter) };
+                stack.push_back(next);
+            }
+        }
     }
 }
 
-void Lexicon::deleteTree(TrieNode* node) {
-    if (node != NULL) {
+/*
+ * Returns a cursor for the given letters, or an invalid cursor if no word
+ * begins with them.  Cursor::descend folds upper case to lower case and
+ * turns any other character into an invalid cursor, which is everything
+ * scrub would have done, without copying the letters anywhere.
+ */
+Lexicon::Cursor Lexicon::trace(const char* letters, size_t length) const {
+    Cursor cur = cursor();
+    for (size_t i = 0; i < length && cur.isValid(); i++) {
+        cur = cur.descend(letters[i]);
+    }
+    return cur;
+}
+
+/*
+ * Rebuilds the pointer trie from a frozen lexicon so that it can be
+ * modified.  Each word keeps the id it had while frozen, and new words are
+ * numbered after them.
+ */
+void Lexicon::thaw() {
+    if (!isFrozen()) {
+        return;
+    }
+    if (!isEmpty()) {
+        thawHelper(m_root, 0, 0);
+    }
+    m_flatNodes.clear();
+    std::vector<FlatNode>().swap(m_flatNodes);
+}
+
+/*
+ * Builds the pointer trie for frozen node index, and everything below it,
+ * into node.  wordId is the id of the first word at or below the node.
+ * The nodes still to be built wait on an explicit stack, each with the
+ * child pointer it hangs from and the id of its first word.
+ */
+void Lexicon::thawHelper(TrieNode*& node, uint32_t index, int wordId) {
+    struct Pending {
+        TrieNode** link;
+        uint32_t index;
+        int wordId;
+    };
+    std::vector<Pending> stack;
+    Pending first = { &node, index, wordId };
+    stack.push_back(first);
+    while (!stack.empty()) {
+        Pending top = stack.back();
+        stack.pop_back();
+        const FlatNode& flat = m_flatNodes[top.index];
+        TrieNode* created = m_arena.allocate();
+        *top.link = created;
+        if (flat.bits & WORD_BIT) {
+            created->setWordId(top.wordId++);
+        }
+        uint32_t child = flat.firstChild;
         for (char letter = 'a'; letter <= 'z'; letter++) {
-            deleteTree(node->child(letter));
+            if (flat.bits & (uint32_t(1) << (letter - 'a'))) {
+                Pending next = { &created->child(letter), child,
+                                 top.wordId + (int) m_flatNodes[child].wordsBefore };
+                stack.push_back(next);
+                child++;
+            }
         }
-        delete node;
     }
 }
 
 /*
  * We just delegate to DawgLexicon, the old implementation, to read a binary
  * lexicon data file, and then we extract its yummy data into our trie.
+ *
+ * If this lexicon is empty, the DAWG's edge array is copied into the frozen
+ * layout as it stands, with no per-word work at all.  The two layouts are
+ * nearly the same: a DAWG keeps the edges out of each node together and in
+ * alphabetical order, so edge i simply becomes frozen node i + 1, below a
+ * new root at index 0.  The DAWG's suffix sharing carries over too, since
+ * several frozen nodes may name the same run of children.  Only the word
+ * counts that cursors use to number the words have to be worked out.
  */
 void Lexicon::readBinaryFile(const std::string& filename) {
     DawgLexicon ldawg(filename);
-    for (std::string word : ldawg) {
-        add(word);
+    if (!isEmpty()) {
+        for (std::string word : ldawg) {
+            add(word);
+        }
+        return;
     }
+    clear();
+    m_flatNodes.resize(ldawg.numEdges + 1);
+    std::vector<uint32_t> listCounts(ldawg.numEdges + 1, UINT32_MAX);
+    FlatNode& root = m_flatNodes[0];
+    root.bits = 0;
+    root.firstChild = 0;
+    root.wordsBefore = 0;
+    if (ldawg.start != NULL) {
+        root.firstChild = (uint32_t) (ldawg.start - ldawg.edges) + 1;
+        m_size = readDawgList(ldawg, root.firstChild - 1, listCounts);
+        for (const DawgLexicon::Edge* edge = ldawg.start; ; edge++) {
+            root.bits |= uint32_t(1) << (edge->letter - 1);
+            if (edge->lastEdge) {
+                break;
+            }
+        }
+    }
+    m_wordIdLimit = m_size;
+}
+
+/*
+ * Fills in the frozen nodes for the run of edges starting at listIndex and
+ * everything below them, and returns the number of words in the run.  Runs
+ * shared by several nodes are only visited once; listCounts remembers their
+ * totals.
+ */
+uint32_t Lexicon::readDawgList(const DawgLexicon& dawg, int listIndex,
+                               std::vector<uint32_t>& listCounts) {
+    if (listCounts[listIndex] != UINT32_MAX) {
+        return listCounts[listIndex];
+    }
+    uint32_t total = 0;
+    for (int i = listIndex; ; i++) {
+        const DawgLexicon::Edge& edge = dawg.edges[i];
+        FlatNode& node = m_flatNodes[i + 1];
+        node.bits = edge.accept ? WORD_BIT : 0;
+        node.firstChild = 0;
+        node.wordsBefore = total;
+        uint32_t count = edge.accept ? 1 : 0;
+        if (edge.children != 0) {
+            node.firstChild = edge.children + 1;
+            count += readDawgList(dawg, edge.children, listCounts);
+            for (const DawgLexicon::Edge* child = &dawg.edges[edge.children]; ; child++) {
+                node.bits |= uint32_t(1) << (child->letter - 1);
+                if (child->lastEdge) {
+                    break;
+                }
+            }
+        }
+        total += count;
+        if (edge.lastEdge) {
+            break;
+        }
+    }
+    listCounts[listIndex] = total;
+    return total;
+}
+
+/*
+ * Implementation notes: NodeArena
+ * -------------------------------
+ * Blocks are raw memory; allocate constructs each node in place.  TrieNode
+ * has nothing to destroy, so the blocks are freed without visiting their
+ * nodes.
+ */
+Lexicon::TrieNode* Lexicon::NodeArena::allocate() {
+    TrieNode* node;
+    if (m_freeNodes != NULL) {
+        node = m_freeNodes;
+        m_freeNodes = node->child('a');
+    } else {
+        if (m_used == NODES_PER_BLOCK) {
+            m_blocks.push_back(static_cast<TrieNode*>(::operator new(NODES_PER_BLOCK * sizeof(TrieNode))));
+            m_used = 0;
+        }
+        node = m_blocks.back() + m_used++;
+    }
+    return new (node) TrieNode();
+}
+
+void Lexicon::NodeArena::release(TrieNode* node) {
+    node->child('a') = m_freeNodes;
+    m_freeNodes = node;
+}
+
+void Lexicon::NodeArena::clear() {
+    for (size_t i = 0; i < m_blocks.size(); i++) {
+        ::operator delete(m_blocks[i]);
+    }
+    m_blocks.clear();
+    m_used = NODES_PER_BLOCK;
+    m_freeNodes = NULL;
+}
+
+/*
+ * Takes over all of the other arena's blocks, leaving it empty.  They go in
+ * front of this arena's blocks so that its partly used last block stays
+ * last; the unused ends of the other arena's blocks are simply not used.
+ */
+void Lexicon::NodeArena::absorb(NodeArena& other) {
+    m_blocks.insert(m_blocks.begin(), other.m_blocks.begin(), other.m_blocks.end());
+    other.m_blocks.clear();
+    other.m_used = NODES_PER_BLOCK;
+    other.m_freeNodes = NULL;
 }
 
 Lexicon& Lexicon::operator=(const Lexicon& src) {
@@ -340,7 +939,17 @@ Lexicon& Lexicon::operator=(const Lexicon& src) {
 }
 
 std::ostream& operator <<(std::ostream& out, const Lexicon& lex) {
-    out << lex.m_allWords;
+    out << "{";
+    bool first = true;
+    for (std::string word : lex) {
+        if (first) {
+            first = false;
+        } else {
+            out << ", ";
+        }
+        writeGenericValue(out, word, true);
+    }
+    out << "}";
     return out;
 }
 
@@ -368,6 +977,51 @@ std::istream& operator >>(std::istream& is, Lexicon& lex) {
     return is;
 }
 
+Lexicon::iterator::iterator(const Lexicon* lex, bool endFlag) {
+    m_lex = lex;
+    m_index = lex->size();
+    if (!endFlag) {
+        m_path.push_back(lex->cursor());
+        if (m_path.back().isValid()) {
+            m_index = -1;
+            advance();
+        }
+    }
+}
+
+/*
+ * Implementation notes: iterator::advance
+ * ---------------------------------------
+ * Moves to the next word in a preorder walk of the trie, which visits the
+ * words in alphabetical order.  From the current prefix, the walk goes down
+ * to the lowest child letter if there is one; otherwise it backs up until
+ * some prefix has a child letter after the one it came from.  It stops at
+ * the first prefix that is a word.  The same code serves both layouts,
+ * since it only looks at the trie through cursors.
+ */
+void Lexicon::iterator::advance() {
+    while (true) {
+        int mask = m_path.back().childMask();
+        while (mask == 0) {
+            if (m_word.empty()) {
+                m_index = m_lex->size();
+                return;
+            }
+            int last = m_word[m_word.length() - 1] - 'a';
+            m_word.erase(m_word.length() - 1);
+            m_path.pop_back();
+            mask = m_path.back().childMask() & ~((2 << last) - 1);
+        }
+        char letter = (char) ('a' + countBits((mask & -mask) - 1));
+        m_path.push_back(m_path.back().descend(letter));
+        m_word.push_back(letter);
+        if (m_path.back().isWord()) {
+            m_index++;
+            return;
+        }
+    }
+}
+
 /*
  * Hash function for lexicons.
  */
@@ -395,6 +1049,70 @@ static bool isDAWGFile(const std::string& filename) {
     return result;
 }
 
+/*
+ * Appends the words on the lines of text[start..end) to words, trimming
+ * and scrubbing each line the way add(trim(line)) does and skipping the
+ * lines it would reject.
+ */
+static void parseWords(const std::string& text, size_t start, size_t end,
+                       std::vector<std::string>& words) {
+    while (start < end) {
+        size_t lineEnd = text.find('\n', start);
+        if (lineEnd == std::string::npos || lineEnd > end) {
+            lineEnd = end;
+        }
+        size_t first = start;
+        size_t last = lineEnd;
+        while (first < last && isspace((unsigned char) text[first])) {
+            first++;
+        }
+        while (last > first && isspace((unsigned char) text[last - 1])) {
+            last--;
+        }
+        std::string word = text.substr(first, last - first);
+        if (!word.empty() && scrub(word)) {
+            words.push_back(word);
+        }
+        start = lineEnd + 1;
+    }
+}
+
+/*
+ * Calls fn(0) through fn(numThreads - 1), each on a thread of its own
+ * except fn(0), which runs on the calling thread, and waits for them all.
+ */
+static void runThreads(int numThreads, const std::function<void(int)>& fn) {
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++) {
+        threads.push_back(std::thread(fn, t));
+    }
+    fn(0);
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+/*
+ * Returns the checksum stored in a snapshot header: the 32-bit FNV-1a hash
+ * of the header's node and word counts followed by the nodes.  The counts
+ * are covered because loadSnapshot takes the word count on trust.  It is a
+ * guard against truncated or damaged files, not against tampering.
+ */
+static uint32_t snapshotChecksum(const SnapshotHeader& header, const void* nodes,
+                                 size_t numBytes) {
+    uint32_t counts[2] = { header.numNodes, header.numWords };
+    uint32_t hash = 2166136261u;
+    const unsigned char* bytes = (const unsigned char*) counts;
+    for (size_t i = 0; i < sizeof(counts); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    bytes = (const unsigned char*) nodes;
+    for (size_t i = 0; i < numBytes; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
 static bool scrub(std::string& str) {
     size_t nChars = str.length();
     size_t outIndex = 0;
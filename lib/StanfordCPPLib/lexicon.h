@@ -5,6 +5,18 @@
  * compact structure for storing a list of words.
  *
  * @author Marty Stepp
+ * @version 2026/10/18
+ * - added Cursor class for walking the lexicon one letter at a time
+ * - added Cursor hasChildren and childMask methods
+ * - added word ids (Cursor wordId method, wordIdLimit)
+ * - added Cursor nodeKey method
+ * - added freeze and isFrozen methods (flat array layout for read-only use)
+ * - binary DAWG files now load straight into the frozen layout
+ * - removed the secondary Set of all words; iteration walks the trie
+ * - added contains/containsPrefix overloads taking a char pointer and length
+ * - added parallel addWordsFromFile with a progress function
+ * - added saveSnapshot and loadSnapshot
+ * - trie nodes come from a block arena owned by the lexicon
  * @version 2014/11/13
  * - added comparison operators <, >= etc.
  * - added hashCode function
@@ -16,12 +28,17 @@
 #ifndef _lexicon_h
 #define _lexicon_h
 
+#include <functional>
 #include <iterator>
 #include <set>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include "hashcode.h"
 #include "set.h"
 
+class DawgLexicon;
+
 /*
  * Class: Lexicon
  * --------------
@@ -61,7 +78,9 @@ public:
      * lexicon.  The second form reads in the contents of the lexicon from
      * the specified data file.  The data file must be in one of two formats:
      * (1) a space-efficient precompiled binary format or (2) a text file
-     * containing one word per line.  The Stanford library distribution
+     * containing one word per line.  A lexicon read from a binary file
+     * starts out frozen (see <code>freeze</code>), which makes loading it
+     * nearly instantaneous.  The Stanford library distribution
      * includes a binary lexicon file named <code>English.dat</code>
      * containing a list of words in English.  The standard code pattern
      * to initialize that lexicon looks like this:
@@ -92,14 +111,40 @@ public:
      */
     bool add(const std::string& word);
 
+    /*
+     * Type: LoadProgress
+     * ------------------
+     * Describes a stage of a parallel <code>addWordsFromFile</code> that
+     * has just finished: its name (<code>"read"</code>, <code>"parse"</code>,
+     * <code>"merge"</code> or <code>"build"</code>), the milliseconds it
+     * took, and the number of words it ended up with.
+     */
+    struct LoadProgress {
+        std::string stage;
+        long elapsedMS;
+        int numWords;
+    };
+
     /*
      * Method: addWordsFromFile
      * Usage: lex.addWordsFromFile(filename);
-     * --------------------------------------
+     *        lex.addWordsFromFile(filename, numThreads);
+     *        lex.addWordsFromFile(filename, numThreads, progress);
+     * ------------------------------------------------------------
      * Reads the file and adds all of its words to the lexicon.
      * Each word from the file is converted to lowercase before adding it.
+     *
+     * <p>Given a number of threads, a text file is read into memory in one
+     * pass and split into that many pieces, whose words are cleaned up and
+     * sorted in parallel.  The sorted runs are then merged, and added to
+     * the trie, in parallel as well, each thread taking the words for a
+     * range of first letters.  A thread count of 0 means one per processor
+     * core.  If a progress function is given, it is called on the calling
+     * thread as each stage of the load finishes.
      */
     void addWordsFromFile(const std::string& filename);
+    void addWordsFromFile(const std::string& filename, int numThreads,
+                          const std::function<void(const LoadProgress&)>& progress = nullptr);
 
     /*
      * Method: clear
@@ -120,6 +165,7 @@ public:
      * containing any non-alphabetic characters such as punctuation or whitespace.
      */
     bool contains(const std::string& word) const;
+    bool contains(const char* word, size_t length) const;
 
     /*
      * Method: containsPrefix
@@ -130,8 +176,24 @@ public:
      * so that "MO" is a prefix of "monkey" or "Monday".
      * The empty string is a prefix of every string, so this method returns
      * true when passed the empty string.
+     *
+     * Both <code>contains</code> and <code>containsPrefix</code> can also
+     * be given the letters as a pointer and a length, so that callers
+     * holding words in their own buffers need not build strings.  Neither
+     * form copies its argument or allocates memory.
      */
     bool containsPrefix(const std::string& prefix) const;
+    bool containsPrefix(const char* prefix, size_t length) const;
+
+    /*
+     * Method: cursor
+     * Usage: Lexicon::Cursor cur = lex.cursor();
+     * ------------------------------------------
+     * Returns a cursor positioned at the empty prefix of this lexicon.
+     * See the <code>Lexicon::Cursor</code> class below for details.
+     */
+    class Cursor;
+    Cursor cursor() const;
 
     /*
      * Method: equals
@@ -141,6 +203,23 @@ public:
      */
     bool equals(const Lexicon& lex2) const;
     
+    /*
+     * Method: freeze
+     * Usage: lex.freeze();
+     * --------------------
+     * Packs the lexicon into a read-only layout that is much smaller and
+     * faster to search than the one used while words are being added.  All
+     * of the trie's nodes are moved into one array in breadth-first order,
+     * so the children of a node sit next to each other, and each node keeps
+     * a 26-bit mask of its child letters instead of 26 pointers.  A frozen
+     * lexicon supports every operation; the first <code>add</code>,
+     * <code>remove</code> or <code>removePrefix</code> quietly unpacks it
+     * again.  Freezing renumbers the word ids so that they run from 0 to
+     * size() - 1 in alphabetical order, and invalidates all cursors.
+     * Freezing a lexicon that is already frozen does nothing.
+     */
+    void freeze();
+
     /*
      * Method: isEmpty
      * Usage: if (lex.isEmpty()) ...
@@ -149,6 +228,29 @@ public:
      */
     bool isEmpty() const;
 
+    /*
+     * Method: isFrozen
+     * Usage: if (lex.isFrozen()) ...
+     * ------------------------------
+     * Returns <code>true</code> if the lexicon is in the read-only layout
+     * made by <code>freeze</code>.
+     */
+    bool isFrozen() const;
+
+    /*
+     * Method: loadSnapshot
+     * Usage: lex.loadSnapshot(filename);
+     * ----------------------------------
+     * Replaces the contents of the lexicon with a snapshot written by
+     * <code>saveSnapshot</code>.  The node array is read in a single
+     * block, with no work per word, and the lexicon ends up frozen with
+     * the same word ids it had when it was saved.  It is an error for the
+     * file not to be a snapshot, to have been written by a different
+     * version of the format or on a machine of the other byte order, or to
+     * fail its checksum.
+     */
+    void loadSnapshot(const std::string& filename);
+
     /*
      * Method: mapAll
      * Usage: lexicon.mapAll(fn);
@@ -186,6 +288,18 @@ public:
      */
     bool removePrefix(const std::string& prefix);
 
+    /*
+     * Method: saveSnapshot
+     * Usage: lex.saveSnapshot(filename);
+     * ----------------------------------
+     * Writes the frozen form of the lexicon to the given file, exactly as
+     * it is laid out in memory, after a header giving the format version
+     * and a checksum of the nodes.  A lexicon that is not frozen is
+     * written as it would be after <code>freeze</code>, but is itself
+     * left as it is.  <code>loadSnapshot</code> reads the file back.
+     */
+    void saveSnapshot(const std::string& filename) const;
+
     /*
      * Method: size
      * Usage: int n = lex.size();
@@ -194,6 +308,22 @@ public:
      */
     int size() const;
 
+    /*
+     * Method: wordIdLimit
+     * Usage: int limit = lex.wordIdLimit();
+     * -------------------------------------
+     * Returns one more than the largest word id handed out so far.  Every
+     * word in the lexicon has a distinct integer id between 0 and
+     * wordIdLimit() - 1, which <code>Lexicon::Cursor::wordId</code> reports
+     * when the cursor reaches the word.  Ids are assigned in the order
+     * words are added and are not reused when words are removed, so they
+     * stay dense unless many words are removed.  Clearing the lexicon
+     * starts the numbering over at 0.  A copy of a lexicon gives every word
+     * the same id as the original does.  Clients can use ids to keep sets of
+     * words as bit vectors rather than as sets of strings.
+     */
+    int wordIdLimit() const;
+
     /*
      * Method: toString
      * Usage: string str = lexicon.toString();
@@ -255,7 +385,7 @@ private:
     struct TrieNode {
     public:
         TrieNode() {
-            m_isWord = false;
+            m_wordId = -1;
             for (int i = 0; i < 26; i++) {
                 m_children[i] = NULL;
             }
@@ -286,39 +416,107 @@ private:
         }
 
         inline bool isWord() {
-            return m_isWord;
+            return m_wordId >= 0;
         }
 
-        inline void setWord(bool value) {
-            m_isWord = value;
+        inline int wordId() {
+            return m_wordId;
+        }
+
+        // pre: id >= 0 to make this node a word, -1 to make it a plain prefix
+        inline void setWordId(int id) {
+            m_wordId = id;
         }
 
     private:
         /* instance variables */
-        bool m_isWord;
+        int m_wordId;               // -1 if this node does not end a word
         TrieNode* m_children[26];   // 0=a, 1=b, 2=c, ..., 25=z
     };
 
+    /*
+     * A node of a frozen lexicon.  The children of a node are stored one
+     * after another in letter order, starting at firstChild, so the child
+     * for a letter is found by counting the lower letters in the mask.
+     * Word ids are not stored; a node instead records how many words come
+     * before it among its siblings, and a cursor adds these up on the way
+     * down to get the alphabetical rank of the word it reaches.
+     */
+    struct FlatNode {
+        uint32_t bits;          // bits 0-25 are child letters 'a'-'z', WORD_BIT ends a word
+        uint32_t firstChild;    // index of the child with the lowest letter
+        uint32_t wordsBefore;   // words in the subtrees of the earlier siblings
+    };
+
+    static const uint32_t LETTER_BITS = (1u << 26) - 1;
+    static const uint32_t WORD_BIT = 1u << 26;
+
+    static inline int countBits(uint32_t bits) {
+#if defined(__GNUC__)
+        return __builtin_popcount(bits);
+#else
+        bits = bits - ((bits >> 1) & 0x55555555);
+        bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+        return (int) ((((bits + (bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+#endif
+    }
+
+    /*
+     * The nodes of the pointer trie are carved one after another out of
+     * large blocks instead of being allocated one at a time.  Nodes given
+     * back by remove and removePrefix go on a free list, linked through
+     * their child pointer for 'a', and are handed out again before the
+     * blocks are touched.  clear returns every block to the heap at once.
+     * An arena is not thread-safe: a parallel load gives each thread an
+     * arena of its own and moves their blocks into the lexicon's arena
+     * once the threads are done.
+     */
+    class NodeArena {
+    public:
+        NodeArena() : m_used(NODES_PER_BLOCK), m_freeNodes(NULL) {}
+        ~NodeArena() { clear(); }
+
+        TrieNode* allocate();
+        void release(TrieNode* node);
+        void clear();
+        void absorb(NodeArena& other);
+
+    private:
+        NodeArena(const NodeArena& src);                // not copyable
+        NodeArena& operator =(const NodeArena& src);
+
+        static const int NODES_PER_BLOCK = 1024;
+
+        std::vector<TrieNode*> m_blocks;
+        int m_used;                 // nodes handed out from the last block
+        TrieNode* m_freeNodes;      // released nodes, to be reused first
+    };
+
     /*
      * private helper functions, including
-     * recursive helpers to implement public add/contains/remove
+     * the helpers that implement public add/remove
      */
-    bool addHelper(TrieNode*& node, const std::string& word, const std::string& originalWord);
-    bool containsHelper(TrieNode* node, const std::string& word, bool isPrefix) const;
+    bool addHelper(TrieNode*& node, const std::string& word);
+    static void addSortedWords(NodeArena& arena, TrieNode* root,
+                               const std::vector<std::string>& words, int firstId);
+    Cursor trace(const char* letters, size_t length) const;
     void deepCopy(const Lexicon& src);
-    void deleteTree(TrieNode* node);
     void readBinaryFile(const std::string& filename);
-    bool removeHelper(TrieNode*& node, const std::string& word, const std::string& originalWord, bool isPrefix);
-    void removeSubtreeHelper(TrieNode*& node, const std::string& originalWord);
+    uint32_t readDawgList(const DawgLexicon& dawg, int listIndex, std::vector<uint32_t>& listCounts);
+    bool removeHelper(TrieNode*& node, const std::string& word, bool isPrefix);
+    void removeSubtreeHelper(TrieNode*& node);
+    void thaw();
+    void thawHelper(TrieNode*& node, uint32_t index, int wordId);
     
     friend std::ostream& operator <<(std::ostream& os, const Lexicon& lex);
     friend std::istream& operator >>(std::istream& is, Lexicon& lex);
 
     /* instance variables */
-    TrieNode* m_root;
+    TrieNode* m_root;                   // NULL while frozen
+    NodeArena m_arena;                  // holds every node under m_root
+    std::vector<FlatNode> m_flatNodes;  // frozen nodes, root first; empty unless frozen
     int m_size;
-    Set<std::string> m_allWords;   // secondary structure of all words for foreach;
-                                   // basically a cop-out so I can loop over words
+    int m_wordIdLimit;
 
 public:
     /*
@@ -335,6 +533,175 @@ public:
     Lexicon(const Lexicon& src);
     Lexicon& operator =(const Lexicon& src);
 
+    /*
+     * Class: Lexicon::Cursor
+     * ----------------------
+     * A cursor marks a prefix within the lexicon and can be extended one
+     * letter at a time.  Searches that build words incrementally, such as
+     * a Boggle board search, can carry a cursor along with the partial
+     * word instead of passing the whole string to <code>contains</code>
+     * and <code>containsPrefix</code> at every step:
+     *
+     *<pre>
+     *    Lexicon::Cursor cur = english.cursor();
+     *    cur = cur.descend('c').descend('a').descend('t');
+     *    if (cur.isWord()) ...
+     *</pre>
+     *
+     * Cursors are small values that never allocate memory.  Any operation
+     * that modifies the lexicon invalidates all of its cursors.
+     */
+    class Cursor {
+    public:
+        /*
+         * Constructor: Cursor
+         * Usage: Lexicon::Cursor cur;
+         * ---------------------------
+         * Creates an invalid cursor that is not positioned in any lexicon.
+         */
+        Cursor() : m_node(NULL), m_flatNodes(NULL), m_flatIndex(0), m_wordBase(0) {}
+
+        /*
+         * Method: descend
+         * Usage: Lexicon::Cursor next = cur.descend(letter);
+         * --------------------------------------------------
+         * Returns a cursor for this prefix extended by the given letter.
+         * Case is ignored.  If no word in the lexicon begins with the
+         * extended prefix, or the letter is not alphabetic, the returned
+         * cursor is invalid.
+         */
+        Cursor descend(char letter) const {
+            if (letter >= 'A' && letter <= 'Z') {
+                letter += 'a' - 'A';
+            }
+            if (letter < 'a' || letter > 'z') {
+                return Cursor();
+            }
+            if (m_flatNodes != NULL) {
+                const FlatNode& node = m_flatNodes[m_flatIndex];
+                uint32_t bit = uint32_t(1) << (letter - 'a');
+                if ((node.bits & bit) == 0) {
+                    return Cursor();
+                }
+                uint32_t child = node.firstChild + countBits(node.bits & (bit - 1));
+                int wordBase = m_wordBase + ((node.bits & WORD_BIT) ? 1 : 0)
+                        + m_flatNodes[child].wordsBefore;
+                return Cursor(m_flatNodes, child, wordBase);
+            }
+            if (m_node == NULL) {
+                return Cursor();
+            }
+            return Cursor(m_node->child(letter));
+        }
+
+        /*
+         * Method: childMask
+         * Usage: int mask = cur.childMask();
+         * ----------------------------------
+         * Returns a bit mask of the letters that can extend this prefix
+         * toward some word in the lexicon.  Bit 0 stands for 'a', bit 1
+         * for 'b', and so on through bit 25 for 'z'.  An invalid cursor
+         * has no children, so its mask is 0.
+         */
+        int childMask() const {
+            if (m_flatNodes != NULL) {
+                return (int) (m_flatNodes[m_flatIndex].bits & LETTER_BITS);
+            }
+            int mask = 0;
+            if (m_node != NULL) {
+                for (char letter = 'a'; letter <= 'z'; letter++) {
+                    if (m_node->child(letter) != NULL) {
+                        mask |= 1 << (letter - 'a');
+                    }
+                }
+            }
+            return mask;
+        }
+
+        /*
+         * Method: hasChildren
+         * Usage: if (cur.hasChildren()) ...
+         * ---------------------------------
+         * Returns <code>true</code> if some word in the lexicon is longer
+         * than the prefix this cursor marks and begins with it.
+         */
+        bool hasChildren() const {
+            if (m_flatNodes != NULL) {
+                return (m_flatNodes[m_flatIndex].bits & LETTER_BITS) != 0;
+            }
+            return m_node != NULL && !m_node->isLeaf();
+        }
+
+        /*
+         * Method: isValid
+         * Usage: if (cur.isValid()) ...
+         * -----------------------------
+         * Returns <code>true</code> if some word in the lexicon begins
+         * with the prefix this cursor marks.
+         */
+        bool isValid() const {
+            return m_node != NULL || m_flatNodes != NULL;
+        }
+
+        /*
+         * Method: isWord
+         * Usage: if (cur.isWord()) ...
+         * ----------------------------
+         * Returns <code>true</code> if the prefix this cursor marks is
+         * itself a word in the lexicon.
+         */
+        bool isWord() const {
+            if (m_flatNodes != NULL) {
+                return (m_flatNodes[m_flatIndex].bits & WORD_BIT) != 0;
+            }
+            return m_node != NULL && m_node->isWord();
+        }
+
+        /*
+         * Method: nodeKey
+         * Usage: uint64_t key = cur.nodeKey();
+         * ------------------------------------
+         * Returns a number that identifies the prefix this cursor marks.
+         * Two cursors into the same lexicon have the same key exactly when
+         * they mark the same prefix, so a search can use the key to
+         * remember prefixes it has already explored.  An invalid cursor
+         * has the key 0.
+         */
+        uint64_t nodeKey() const {
+            if (m_flatNodes != NULL) {
+                return (uint64_t(1) << 63) | (uint64_t(m_flatIndex) << 32) | uint32_t(m_wordBase);
+            }
+            return (uint64_t) (uintptr_t) m_node;
+        }
+
+        /*
+         * Method: wordId
+         * Usage: int id = cur.wordId();
+         * -----------------------------
+         * Returns the id of the word this cursor marks, or -1 if the
+         * prefix is not a word.  See <code>Lexicon::wordIdLimit</code>.
+         */
+        int wordId() const {
+            if (m_flatNodes != NULL) {
+                return (m_flatNodes[m_flatIndex].bits & WORD_BIT) ? m_wordBase : -1;
+            }
+            return m_node == NULL ? -1 : m_node->wordId();
+        }
+
+    private:
+        explicit Cursor(TrieNode* node)
+            : m_node(node), m_flatNodes(NULL), m_flatIndex(0), m_wordBase(0) {}
+        Cursor(const FlatNode* flatNodes, uint32_t index, int wordBase)
+            : m_node(NULL), m_flatNodes(flatNodes), m_flatIndex(index), m_wordBase(wordBase) {}
+
+        TrieNode* m_node;               // node of an unfrozen lexicon
+        const FlatNode* m_flatNodes;    // node array of a frozen lexicon, else NULL
+        uint32_t m_flatIndex;           // index of this prefix's node in m_flatNodes
+        int m_wordBase;                 // id of the first word that begins with this prefix
+
+        friend class Lexicon;
+    };
+
     /*
      * Iterator support
      * ----------------
@@ -342,25 +709,62 @@ public:
      * iterators so that they work symmetrically with respect to the
      * corresponding STL classes.
      */
-    class iterator : public Set<std::string>::iterator {
+    class iterator : public std::iterator<std::input_iterator_tag, std::string> {
     public:
-        iterator() : Set<std::string>::iterator() {}
-        iterator(const iterator& it) : Set<std::string>::iterator(it) {}
-        iterator(const Set<std::string>::iterator& it) : Set<std::string>::iterator(it) {}
+        iterator() : m_lex(NULL), m_index(0) {
+            /* empty */
+        }
+
+        iterator(const Lexicon* lex, bool endFlag);
+
+        iterator& operator ++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            advance();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) const {
+            return m_lex == rhs.m_lex && m_index == rhs.m_index;
+        }
+
+        bool operator !=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        const std::string& operator *() const {
+            return m_word;
+        }
+
+        const std::string* operator ->() const {
+            return &m_word;
+        }
+
+    private:
+        void advance();
+
+        const Lexicon* m_lex;
+        int m_index;                    // number of words before m_word; size() at the end
+        std::string m_word;             // the current word
+        std::vector<Cursor> m_path;     // m_path[i] marks the first i letters of m_word
     };
 
     /*
      * Returns an iterator positioned at the first word in the lexicon.
      */
     iterator begin() const {
-        return iterator(m_allWords.begin());
+        return iterator(this, false);
     }
 
     /*
      * Returns an iterator positioned at the last word in the lexicon.
      */
     iterator end() const {
-        return iterator(m_allWords.end());
+        return iterator(this, true);
     }
 };
 
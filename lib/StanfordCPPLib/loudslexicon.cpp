@@ -0,0 +1,405 @@
+/*
+ * File: loudslexicon.cpp
+ * ----------------------
+ * Implements the LoudsLexicon class.  See loudslexicon.h for the interface
+ * and the meaning of the arrays.
+ *
+ * The LOUDS representation of trees is due to Jacobson, "Space-efficient
+ * static trees and graphs" (FOCS 1989).  The trie is built breadth-first
+ * from the cursors of a Lexicon, which visits the nodes in exactly the
+ * level order the encoding needs.
+ *
+ * @version 2026/10/18
+ * - initial version
+ */
+
+#ifndef _WIN32
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+#include "loudslexicon.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "error.h"
+#include "strlib.h"
+
+/*
+ * Header of the binary format.  The storage block follows it directly, as
+ * 64-bit words in the byte order of the machine that wrote the file.
+ */
+struct LoudsFileHeader {
+    char magic[8];          // LOUDS_MAGIC
+    uint32_t byteOrder;     // BYTE_ORDER_MARK as written
+    uint32_t version;       // LOUDS_VERSION
+    uint32_t numNodes;
+    uint32_t numWords;
+    uint32_t reserved[2];   // 0
+};
+
+static const char LOUDS_MAGIC[8] = { 'L', 'O', 'U', 'D', 'S', 'L', 'E', 'X' };
+static const uint32_t LOUDS_VERSION = 1;
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+LoudsLexicon::LoudsLexicon() {
+    m_mappedFile = NULL;
+    m_mappedSize = 0;
+    build(Lexicon());
+}
+
+LoudsLexicon::LoudsLexicon(const Lexicon& lexicon) {
+    m_mappedFile = NULL;
+    m_mappedSize = 0;
+    build(lexicon);
+}
+
+LoudsLexicon::LoudsLexicon(const std::string& filename) {
+    m_mappedFile = NULL;
+    m_mappedSize = 0;
+    if (!readBinaryFile(filename)) {
+        build(Lexicon(filename));
+    }
+}
+
+LoudsLexicon::LoudsLexicon(const LoudsLexicon& src) {
+    m_mappedFile = NULL;
+    m_mappedSize = 0;
+    deepCopy(src);
+}
+
+LoudsLexicon::~LoudsLexicon() {
+    release();
+}
+
+bool LoudsLexicon::contains(const std::string& word) const {
+    return contains(word.data(), word.length());
+}
+
+bool LoudsLexicon::contains(const char* word, size_t length) const {
+    return length > 0 && trace(word, length).isWord();
+}
+
+bool LoudsLexicon::containsPrefix(const std::string& prefix) const {
+    return containsPrefix(prefix.data(), prefix.length());
+}
+
+bool LoudsLexicon::containsPrefix(const char* prefix, size_t length) const {
+    return length == 0 || trace(prefix, length).isValid();
+}
+
+LoudsLexicon::Cursor LoudsLexicon::cursor() const {
+    return isEmpty() ? Cursor() : Cursor(this, 0);
+}
+
+bool LoudsLexicon::equals(const LoudsLexicon& lex2) const {
+    if (this == &lex2) {
+        return true;
+    }
+    if (size() != lex2.size()) {
+        return false;
+    }
+    for (iterator it1 = begin(), it2 = lex2.begin(); it1 != end(); ++it1, ++it2) {
+        if (*it1 != *it2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoudsLexicon::isEmpty() const {
+    return m_numWords == 0;
+}
+
+int LoudsLexicon::size() const {
+    return m_numWords;
+}
+
+std::string LoudsLexicon::toString() const {
+    std::ostringstream out;
+    out << *this;
+    return out.str();
+}
+
+std::set<std::string> LoudsLexicon::toStlSet() const {
+    std::set<std::string> result;
+    for (std::string word : *this) {
+        result.insert(word);
+    }
+    return result;
+}
+
+void LoudsLexicon::writeBinaryFile(const std::string& filename) const {
+    LoudsFileHeader header;
+    memcpy(header.magic, LOUDS_MAGIC, sizeof(LOUDS_MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = LOUDS_VERSION;
+    header.numNodes = m_numNodes;
+    header.numWords = (uint32_t) m_numWords;
+    header.reserved[0] = header.reserved[1] = 0;
+    std::ofstream ostr(filename.c_str(), std::ios::out | std::ios::binary);
+    if (ostr.fail()) {
+        error("LoudsLexicon::writeBinaryFile: Couldn't open lexicon file " + filename);
+    }
+    ostr.write((const char*) &header, sizeof(header));
+    ostr.write((const char*) m_louds, storageWords() * sizeof(uint64_t));
+    ostr.close();
+    if (ostr.fail()) {
+        error("LoudsLexicon::writeBinaryFile: Couldn't write lexicon file " + filename);
+    }
+}
+
+bool LoudsLexicon::operator ==(const LoudsLexicon& lex2) const {
+    return equals(lex2);
+}
+
+bool LoudsLexicon::operator !=(const LoudsLexicon& lex2) const {
+    return !equals(lex2);
+}
+
+LoudsLexicon& LoudsLexicon::operator =(const LoudsLexicon& src) {
+    if (this != &src) {
+        release();
+        deepCopy(src);
+    }
+    return *this;
+}
+
+/*
+ * Implementation notes: build
+ * ---------------------------
+ * The first pass walks the lexicon breadth-first, collecting each node's
+ * letter, number of children and end-of-word flag; once the number of
+ * nodes is known, the second pass lays out the storage block and writes
+ * the bit strings and directories into it.
+ */
+void LoudsLexicon::build(const Lexicon& lexicon) {
+    std::vector<Lexicon::Cursor> queue;
+    std::vector<uint8_t> labels;
+    std::vector<uint8_t> degrees;
+    queue.push_back(lexicon.cursor());
+    for (size_t i = 0; i < queue.size(); i++) {
+        int mask = queue[i].isValid() ? queue[i].childMask() : 0;
+        int degree = 0;
+        for (int letter = 0; letter < 26; letter++) {
+            if (mask & (1 << letter)) {
+                queue.push_back(queue[i].descend((char) ('a' + letter)));
+                labels.push_back((uint8_t) ('a' + letter));
+                degree++;
+            }
+        }
+        degrees.push_back((uint8_t) degree);
+    }
+
+    m_numNodes = (uint32_t) queue.size();
+    m_numWords = 0;
+    m_storage.assign(storageWords(), 0);
+    setLayout(&m_storage[0]);
+    uint64_t* louds = const_cast<uint64_t*>(m_louds);
+    uint32_t* zeroSamples = const_cast<uint32_t*>(m_zeroSamples);
+    uint64_t* terminal = const_cast<uint64_t*>(m_terminal);
+    uint32_t* terminalRanks = const_cast<uint32_t*>(m_terminalRanks);
+    if (!labels.empty()) {
+        memcpy(const_cast<uint8_t*>(m_labels), &labels[0], labels.size());
+    }
+
+    uint32_t pos = 0;
+    for (uint32_t x = 0; x < m_numNodes; x++) {
+        for (int k = 0; k < degrees[x]; k++, pos++) {
+            louds[pos / 64] |= 1ULL << (pos % 64);
+        }
+        if (x % SAMPLE_RATE == 0) {
+            zeroSamples[x / SAMPLE_RATE] = pos;
+        }
+        pos++;
+        if (x % RANK_BLOCK == 0) {
+            terminalRanks[x / RANK_BLOCK] = (uint32_t) m_numWords;
+        }
+        if (queue[x].isWord()) {
+            terminal[x / 64] |= 1ULL << (x % 64);
+            m_numWords++;
+        }
+    }
+}
+
+void LoudsLexicon::deepCopy(const LoudsLexicon& src) {
+    m_numNodes = src.m_numNodes;
+    m_numWords = src.m_numWords;
+    m_storage.assign(src.m_louds, src.m_louds + src.storageWords());
+    setLayout(&m_storage[0]);
+}
+
+/*
+ * Implementation notes: readBinaryFile
+ * ------------------------------------
+ * Returns false, having read nothing, if the file was not written by
+ * writeBinaryFile.  Otherwise the file is mapped into memory read-only and
+ * the arrays are used right where they sit, so nothing but the header is
+ * read until searches reach the rest.  Where there is no mmap, the storage
+ * block is read into m_storage instead.
+ */
+bool LoudsLexicon::readBinaryFile(const std::string& filename) {
+    LoudsFileHeader header;
+    std::ifstream istr(filename.c_str(), std::ios::in | std::ios::binary);
+    if (istr.fail()) {
+        error("LoudsLexicon::LoudsLexicon: Couldn't open lexicon file " + filename);
+    }
+    istr.read((char*) &header, sizeof(header));
+    if (istr.fail() || memcmp(header.magic, LOUDS_MAGIC, sizeof(LOUDS_MAGIC)) != 0) {
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        error("LoudsLexicon::LoudsLexicon: Lexicon file " + filename
+              + " was written on a machine of the other byte order");
+    }
+    if (header.version != LOUDS_VERSION) {
+        error("LoudsLexicon::LoudsLexicon: Unsupported lexicon file version in " + filename);
+    }
+    if (header.numNodes == 0 || header.numNodes > (1u << 30) || header.numWords > header.numNodes) {
+        error("LoudsLexicon::LoudsLexicon: Improperly formed lexicon file " + filename);
+    }
+    m_numNodes = header.numNodes;
+    m_numWords = (int) header.numWords;
+    size_t fileSize = sizeof(header) + storageWords() * sizeof(uint64_t);
+
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd >= 0 && fstat(fd, &info) == 0 && (size_t) info.st_size >= fileSize) {
+        void* data = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data != MAP_FAILED) {
+            m_mappedFile = data;
+            m_mappedSize = fileSize;
+            setLayout((const uint64_t*) ((char*) data + sizeof(header)));
+            return true;
+        }
+    } else if (fd >= 0) {
+        close(fd);
+    }
+#endif
+
+    m_storage.resize(storageWords());
+    istr.read((char*) &m_storage[0], m_storage.size() * sizeof(uint64_t));
+    if (istr.fail()) {
+        error("LoudsLexicon::LoudsLexicon: Improperly formed lexicon file " + filename);
+    }
+    setLayout(&m_storage[0]);
+    return true;
+}
+
+/*
+ * Frees the storage block, or unmaps it if it lives in a mapped file.
+ */
+void LoudsLexicon::release() {
+#ifndef _WIN32
+    if (m_mappedFile != NULL) {
+        munmap(m_mappedFile, m_mappedSize);
+        m_mappedFile = NULL;
+        m_mappedSize = 0;
+    }
+#endif
+    m_storage.clear();
+}
+
+/*
+ * Implementation notes: setLayout, storageWords
+ * ---------------------------------------------
+ * The arrays follow one another in the storage block in the order
+ * m_louds, m_zeroSamples, m_labels, m_terminal, m_terminalRanks, each
+ * padded to a whole number of 64-bit words.  Their sizes depend only on
+ * the number of nodes.  m_louds has a spare word at the end so that
+ * countChildren can always read the word after the one it starts in.
+ */
+static size_t wordsFor(size_t count, size_t perWord) {
+    return (count + perWord - 1) / perWord;
+}
+
+void LoudsLexicon::setLayout(const uint64_t* data) {
+    m_louds = data;
+    data += wordsFor(2 * m_numNodes - 1, 64) + 1;
+    m_zeroSamples = (const uint32_t*) data;
+    data += wordsFor(wordsFor(m_numNodes, SAMPLE_RATE), 2);
+    m_labels = (const uint8_t*) data;
+    data += wordsFor(m_numNodes - 1, 8);
+    m_terminal = data;
+    data += wordsFor(m_numNodes, 64);
+    m_terminalRanks = (const uint32_t*) data;
+}
+
+size_t LoudsLexicon::storageWords() const {
+    return wordsFor(2 * m_numNodes - 1, 64) + 1
+            + wordsFor(wordsFor(m_numNodes, SAMPLE_RATE), 2)
+            + wordsFor(m_numNodes - 1, 8)
+            + wordsFor(m_numNodes, 64)
+            + wordsFor(wordsFor(m_numNodes, RANK_BLOCK), 2);
+}
+
+LoudsLexicon::Cursor LoudsLexicon::trace(const char* letters, size_t length) const {
+    Cursor cur = cursor();
+    for (size_t i = 0; i < length && cur.isValid(); i++) {
+        cur = cur.descend(letters[i]);
+    }
+    return cur;
+}
+
+LoudsLexicon::iterator::iterator(const LoudsLexicon* lex, bool endFlag) {
+    m_lex = lex;
+    m_index = lex->size();
+    if (!endFlag && !lex->isEmpty()) {
+        m_path.push_back(lex->cursor());
+        m_index = -1;
+        advance();
+    }
+}
+
+/*
+ * Implementation notes: iterator::advance
+ * ---------------------------------------
+ * A preorder walk of the trie, as in Lexicon::iterator.  Children are
+ * numbered from 0 within their parent's run of 1s; after backing out of
+ * child k, the walk carries on with child k + 1.
+ */
+void LoudsLexicon::iterator::advance() {
+    int k = 0;
+    while (true) {
+        Cursor top = m_path.back();
+        if (k < top.m_numChildren) {
+            Cursor next = top.child(k);
+            m_path.push_back(next);
+            m_word.push_back((char) m_lex->m_labels[next.m_node - 1]);
+            if (next.isWord()) {
+                m_index++;
+                return;
+            }
+            k = 0;
+        } else {
+            if (m_path.size() == 1) {
+                m_index = m_lex->size();
+                return;
+            }
+            m_path.pop_back();
+            m_word.erase(m_word.length() - 1);
+            const Cursor& parent = m_path.back();
+            k = (int) (top.m_node - (parent.m_firstChild - parent.m_node + 1)) + 1;
+        }
+    }
+}
+
+std::ostream& operator <<(std::ostream& out, const LoudsLexicon& lex) {
+    out << "{";
+    bool first = true;
+    for (std::string word : lex) {
+        if (first) {
+            first = false;
+        } else {
+            out << ", ";
+        }
+        writeGenericValue(out, word, true);
+    }
+    out << "}";
+    return out;
+}
@@ -0,0 +1,456 @@
+/*
+ * File: loudslexicon.h
+ * --------------------
+ * This file exports the <code>LoudsLexicon</code> class, a read-only word
+ * list stored as a succinct (LOUDS-encoded) trie.
+ *
+ * @version 2026/10/18
+ * - initial version
+ */
+
+#ifndef _loudslexicon_h
+#define _loudslexicon_h
+
+#include <iterator>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "lexicon.h"
+
+/*
+ * Class: LoudsLexicon
+ * -------------------
+ * This class represents a fixed <b><i>lexicon,</i></b> or word list, with
+ * the same lookup operations as <code>Lexicon</code>, in as little memory
+ * as a trie can be kept in and still be searched directly.  It is built
+ * once, from a <code>Lexicon</code> or a lexicon file, and cannot be
+ * changed afterwards.
+ *
+ * <p>The trie's shape is kept as a string of bits in level order (LOUDS,
+ * the level-order unary degree sequence): each node contributes a
+ * 1 for every child followed by a 0.  Together with one byte for each
+ * node's letter, one bit saying whether it ends a word, and small rank
+ * and select directories, that comes to about 12 bits per node, against
+ * 96 for a frozen <code>Lexicon</code>.  Moving from a node to a child
+ * costs one select on the bit string and a scan of at most 26 letters.
+ *
+ * <p>A lexicon can be written to a file with <code>writeBinaryFile</code>.
+ * The file holds the arrays exactly as they are laid out in memory, so
+ * reading it back maps the file instead of copying it.
+ *
+ *<pre>
+ *    LoudsLexicon english("EnglishWords.dat");
+ *    if (english.contains("zebra")) ...
+ *</pre>
+ */
+
+class LoudsLexicon {
+public:
+    /*
+     * Constructor: LoudsLexicon
+     * Usage: LoudsLexicon lex;
+     *        LoudsLexicon lex(lexicon);
+     *        LoudsLexicon lex(filename);
+     * ----------------------------------
+     * Builds a lexicon holding the same words as the given
+     * <code>Lexicon</code>, or as the given file.  The file may have been
+     * written by <code>writeBinaryFile</code>, in which case it is mapped
+     * into memory, or be in any format the <code>Lexicon</code> constructor
+     * accepts.  The default constructor creates an empty lexicon.
+     */
+    LoudsLexicon();
+    LoudsLexicon(const Lexicon& lexicon);
+    LoudsLexicon(const std::string& filename);
+
+    /*
+     * Destructor: ~LoudsLexicon
+     * -------------------------
+     * Frees the storage of the lexicon, or unmaps the file it was read from.
+     */
+    virtual ~LoudsLexicon();
+
+    /*
+     * Method: contains
+     * Usage: if (lex.contains(word)) ...
+     * ----------------------------------
+     * Returns <code>true</code> if <code>word</code> is contained in the
+     * lexicon.  Case is ignored, as in <code>Lexicon</code>.
+     */
+    bool contains(const std::string& word) const;
+    bool contains(const char* word, size_t length) const;
+
+    /*
+     * Method: containsPrefix
+     * Usage: if (lex.containsPrefix(prefix)) ...
+     * ------------------------------------------
+     * Returns <code>true</code> if any words in the lexicon begin with
+     * <code>prefix</code>.  The empty string is a prefix of every string.
+     */
+    bool containsPrefix(const std::string& prefix) const;
+    bool containsPrefix(const char* prefix, size_t length) const;
+
+    /*
+     * Method: cursor
+     * Usage: LoudsLexicon::Cursor cur = lex.cursor();
+     * -----------------------------------------------
+     * Returns a cursor positioned at the empty prefix of this lexicon.
+     * See the <code>LoudsLexicon::Cursor</code> class below.
+     */
+    class Cursor;
+    Cursor cursor() const;
+
+    /*
+     * Method: equals
+     * Usage: if (lex1.equals(lex2)) ...
+     * ---------------------------------
+     * Returns <code>true</code> if the two lexicons contain the same words.
+     */
+    bool equals(const LoudsLexicon& lex2) const;
+
+    /*
+     * Method: isEmpty
+     * Usage: if (lex.isEmpty()) ...
+     * -----------------------------
+     * Returns <code>true</code> if the lexicon contains no words.
+     */
+    bool isEmpty() const;
+
+    /*
+     * Method: size
+     * Usage: int n = lex.size();
+     * --------------------------
+     * Returns the number of words contained in the lexicon.
+     */
+    int size() const;
+
+    /*
+     * Method: toString
+     * Usage: string str = lex.toString();
+     * -----------------------------------
+     * Converts the lexicon to a printable string representation.
+     */
+    std::string toString() const;
+
+    /*
+     * Returns an STL set object with the same elements as this lexicon.
+     */
+    std::set<std::string> toStlSet() const;
+
+    /*
+     * Method: writeBinaryFile
+     * Usage: lex.writeBinaryFile(filename);
+     * -------------------------------------
+     * Writes the lexicon to the given file, in a form the constructor maps
+     * straight into memory.  The file holds the arrays in the byte order of
+     * this machine and can only be read on a machine of the same order.
+     */
+    void writeBinaryFile(const std::string& filename) const;
+
+    /*
+     * Operators: ==, !=
+     * Usage: if (lex1 == lex2) ...
+     * ----------------------------
+     * Relational operators to compare two lexicons to see if they have the same elements.
+     */
+    bool operator ==(const LoudsLexicon& lex2) const;
+    bool operator !=(const LoudsLexicon& lex2) const;
+
+    /*
+     * Additional LoudsLexicon operations
+     * ----------------------------------
+     * The LoudsLexicon class can be copied and assigned, and its words can
+     * be visited in alphabetical order with the range-based for statement
+     * and STL iterators.
+     */
+    LoudsLexicon(const LoudsLexicon& src);
+    LoudsLexicon& operator =(const LoudsLexicon& src);
+
+    /* Private section */
+
+    /**********************************************************************/
+    /* Note: Everything below this point in the file is logically part    */
+    /* of the implementation and should not be of interest to clients.    */
+    /**********************************************************************/
+private:
+    /*
+     * The nodes are numbered 0 to m_numNodes - 1 in level order, with the
+     * root as 0.  In m_louds, node x's children are the run of 1s that
+     * follows the x-th 0 (or starts the string, for the root), so a run
+     * starting at bit p belongs to the node with p - x 1s before it, and
+     * the child at bit p + k is node p - x + k + 1.  m_labels[y - 1] is
+     * the letter leading to node y, and bit y of m_terminal is set if
+     * node y ends a word.
+     *
+     * m_zeroSamples[i] is the position of 0 number 64 * i, which narrows a
+     * select to a word or two of m_louds; m_terminalRanks[i] is the number
+     * of words among the first 256 * i nodes.  A word's id is its rank
+     * among the words in level order.
+     *
+     * All of the arrays live in one block, either m_storage or a mapped
+     * file, and point into it.
+     */
+    static const int SAMPLE_RATE = 64;          // 0s between entries of m_zeroSamples
+    static const int RANK_BLOCK = 256;          // nodes between entries of m_terminalRanks
+
+    static inline int countBits(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_popcountll(bits);
+#else
+        bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+        bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+        bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (int) ((bits * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /* Returns the number of 0s below the lowest 1 in bits, which must not be 0 */
+    static inline int countTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        return countBits((bits & (0 - bits)) - 1);
+#endif
+    }
+
+    /* Returns the number of 1s below the lowest 0 in bits */
+    static inline int countTrailingOnes(uint64_t bits) {
+        return (~bits == 0) ? 64 : countTrailingZeros(~bits);
+    }
+
+    /*
+     * Returns the position of the 1 numbered k, from 0, in bits.  The byte
+     * holding it is found without a loop, by comparing k with the running
+     * totals of 1s in all eight bytes at once.
+     */
+    static inline int selectInWord(uint64_t bits, int k) {
+        const uint64_t ONES = 0x0101010101010101ULL;
+        const uint64_t HIGHS = 0x8080808080808080ULL;
+        uint64_t sums = bits - ((bits >> 1) & 0x5555555555555555ULL);
+        sums = (sums & 0x3333333333333333ULL) + ((sums >> 2) & 0x3333333333333333ULL);
+        sums = ((sums + (sums >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * ONES;
+        int shift = countBits((((uint64_t) k * ONES | HIGHS) - sums) & HIGHS) * 8;
+        k -= (int) (((sums << 8) >> shift) & 0xFF);
+        bits >>= shift;
+        for (; k > 0; k--) {
+            bits &= bits - 1;
+        }
+        return shift + countTrailingZeros(bits);
+    }
+
+    /* Returns the position in m_louds of the first child of node x */
+    uint32_t firstChildBit(uint32_t x) const {
+        if (x == 0) {
+            return 0;
+        }
+        uint32_t j = x - 1;
+        uint32_t pos = m_zeroSamples[j / SAMPLE_RATE];
+        uint32_t remaining = j % SAMPLE_RATE;
+        uint32_t w = pos / 64;
+        uint64_t zeros = ~m_louds[w] & (~0ULL << (pos % 64));
+        int n = countBits(zeros);
+        while (remaining >= (uint32_t) n) {
+            remaining -= n;
+            zeros = ~m_louds[++w];
+            n = countBits(zeros);
+        }
+        return w * 64 + selectInWord(zeros, remaining) + 1;
+    }
+
+    /* Returns the number of 1s in m_louds starting at bit pos */
+    int countChildren(uint32_t pos) const {
+        uint32_t w = pos / 64;
+        uint32_t offset = pos % 64;
+        uint64_t bits = m_louds[w] >> offset;
+        if (offset != 0) {
+            bits |= m_louds[w + 1] << (64 - offset);
+        }
+        return countTrailingOnes(bits);
+    }
+
+    bool isTerminal(uint32_t x) const {
+        return (m_terminal[x / 64] >> (x % 64)) & 1;
+    }
+
+    int terminalRank(uint32_t x) const {
+        int rank = m_terminalRanks[x / RANK_BLOCK];
+        for (uint32_t w = x / RANK_BLOCK * (RANK_BLOCK / 64); w < x / 64; w++) {
+            rank += countBits(m_terminal[w]);
+        }
+        return rank + countBits(m_terminal[x / 64] & ((1ULL << (x % 64)) - 1));
+    }
+
+    void build(const Lexicon& lexicon);
+    void deepCopy(const LoudsLexicon& src);
+    bool readBinaryFile(const std::string& filename);
+    void release();
+    void setLayout(const uint64_t* data);
+    size_t storageWords() const;
+    Cursor trace(const char* letters, size_t length) const;
+
+    /* instance variables */
+    uint32_t m_numNodes;
+    int m_numWords;
+    const uint64_t* m_louds;
+    const uint32_t* m_zeroSamples;
+    const uint8_t* m_labels;
+    const uint64_t* m_terminal;
+    const uint32_t* m_terminalRanks;
+    std::vector<uint64_t> m_storage;    // holds the arrays unless they are mapped
+    void* m_mappedFile;                 // mapped file holding the arrays, or NULL
+    size_t m_mappedSize;
+
+public:
+    /*
+     * Class: LoudsLexicon::Cursor
+     * ---------------------------
+     * A cursor marks a prefix within the lexicon and can be extended one
+     * letter at a time, exactly like <code>Lexicon::Cursor</code>.  Word
+     * ids run from 0 to size() - 1, in order of length and then
+     * alphabetically rather than purely alphabetically.
+     */
+    class Cursor {
+    public:
+        Cursor() : m_lex(NULL), m_node(0), m_firstChild(0), m_numChildren(0) {}
+
+        /*
+         * Method: descend
+         * Usage: LoudsLexicon::Cursor next = cur.descend(letter);
+         * -------------------------------------------------------
+         * Returns a cursor for this prefix extended by the given letter, or
+         * an invalid cursor if no word begins with the longer prefix.
+         */
+        Cursor descend(char letter) const {
+            if (letter >= 'A' && letter <= 'Z') {
+                letter += 'a' - 'A';
+            }
+            uint32_t first = m_firstChild - m_node;     // index of first child's label
+            for (int k = 0; k < m_numChildren; k++) {
+                char label = (char) m_lex->m_labels[first + k];
+                if (label >= letter) {
+                    return (label == letter) ? child(k) : Cursor();
+                }
+            }
+            return Cursor();
+        }
+
+        /*
+         * Methods: childMask, hasChildren, isValid, isWord, nodeKey, wordId
+         * -----------------------------------------------------------------
+         * These methods behave as they do in <code>Lexicon::Cursor</code>.
+         */
+        int childMask() const {
+            int mask = 0;
+            uint32_t first = m_firstChild - m_node;
+            for (int k = 0; k < m_numChildren; k++) {
+                mask |= 1 << (m_lex->m_labels[first + k] - 'a');
+            }
+            return mask;
+        }
+
+        bool hasChildren() const {
+            return m_numChildren != 0;
+        }
+
+        bool isValid() const {
+            return m_lex != NULL;
+        }
+
+        bool isWord() const {
+            return m_lex != NULL && m_lex->isTerminal(m_node);
+        }
+
+        uint64_t nodeKey() const {
+            return m_lex == NULL ? 0 : (uint64_t) m_node + 1;
+        }
+
+        int wordId() const {
+            return isWord() ? m_lex->terminalRank(m_node) : -1;
+        }
+
+    private:
+        Cursor(const LoudsLexicon* lex, uint32_t node) {
+            m_lex = lex;
+            m_node = node;
+            m_firstChild = lex->firstChildBit(node);
+            m_numChildren = lex->countChildren(m_firstChild);
+        }
+
+        /* Returns a cursor for child number k of this node */
+        Cursor child(int k) const {
+            return Cursor(m_lex, m_firstChild - m_node + k + 1);
+        }
+
+        const LoudsLexicon* m_lex;      // NULL if the cursor is invalid
+        uint32_t m_node;
+        uint32_t m_firstChild;          // position in m_louds of the node's run of 1s
+        int m_numChildren;
+
+        friend class LoudsLexicon;
+    };
+
+    /*
+     * Iterator support
+     * ----------------
+     * The iterator walks the trie in alphabetical order, keeping a cursor
+     * for every prefix of the current word.
+     */
+    class iterator : public std::iterator<std::input_iterator_tag, std::string> {
+    public:
+        iterator() : m_lex(NULL), m_index(0) {
+            /* empty */
+        }
+
+        iterator(const LoudsLexicon* lex, bool endFlag);
+
+        iterator& operator ++() {
+            advance();
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            iterator copy(*this);
+            advance();
+            return copy;
+        }
+
+        bool operator ==(const iterator& rhs) const {
+            return m_lex == rhs.m_lex && m_index == rhs.m_index;
+        }
+
+        bool operator !=(const iterator& rhs) const {
+            return !(*this == rhs);
+        }
+
+        const std::string& operator *() const {
+            return m_word;
+        }
+
+        const std::string* operator ->() const {
+            return &m_word;
+        }
+
+    private:
+        void advance();
+
+        const LoudsLexicon* m_lex;
+        int m_index;                    // number of words before m_word; size() at the end
+        std::string m_word;             // the current word
+        std::vector<Cursor> m_path;     // m_path[i] marks the first i letters
+    };
+
+    iterator begin() const {
+        return iterator(this, false);
+    }
+
+    iterator end() const {
+        return iterator(this, true);
+    }
+};
+
+/*
+ * Prints the lexicon to the given output stream.
+ */
+std::ostream& operator <<(std::ostream& os, const LoudsLexicon& lex);
+
+#endif
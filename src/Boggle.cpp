@@ -5,8 +5,10 @@
  */
 
 #include <iostream>
+#include "boggleboard.h"
+#include "bogglesolver.h"
+#include "foundwords.h"
 #include "gboggle.h"
-#include "grid.h"
 #include "gwindow.h"
 #include "lexicon.h"
 #include "random.h"
@@ -21,47 +23,59 @@ const int BOGGLE_WINDOW_HEIGHT = 350;
 const int MINIMUM_WORD_LENGTH = 4;
 const int STANDARD = 4;
 const int BIG_BOGGLE = 5;
+const int SUPER_BIG_BOGGLE = 6;
+const int MAX_DIMENSION = 8;
 
 const string STANDARD_CUBES[16]  = {
     "AAEEGN", "ABBJOO", "ACHOPS", "AFFKPS",
     "AOOTTW", "CIMOTU", "DEILRX", "DELRVY",
     "DISTTY", "EEGHNW", "EEINSU", "EHRTVW",
-    "EIOSST", "ELRTTY", "HIMNQU", "HLNNRZ"
+    "EIOSST", "ELRTTY", "HIMN(QU)U", "HLNNRZ"
 };
 
 const string BIG_BOGGLE_CUBES[25]  = {
     "AAAFRS", "AAEEEE", "AAFIRS", "ADENNN", "AEEEEM",
-    "AEEGMU", "AEGMNN", "AFIRSY", "BJKQXZ", "CCNSTW",
+    "AEEGMU", "AEGMNN", "AFIRSY", "BJK(QU)XZ", "CCNSTW",
     "CEIILT", "CEILPT", "CEIPST", "DDLNOR", "DDHNOT",
     "DHHLOR", "DHLNOR", "EIIITT", "EMOTTT", "ENSSSU",
     "FIPRSY", "GORRVW", "HIPRRY", "NOOTUW", "OOOTTU"
 };
 
+/* A face of several letters is written in parentheses; # is a blank face */
+
+const string SUPER_BIG_BOGGLE_CUBES[36]  = {
+    "AAAFRS", "AAEEEE", "AAEEOO", "AAFIRS", "ABDEIO", "ADENNN",
+    "AEEEEM", "AEEGMU", "AEGMNN", "AEILMN", "AEINOU", "AFIRSY",
+    "(AN)(ER)(HE)(IN)(QU)(TH)", "BBJKXZ", "CCENST", "CDDLNN", "CEIITT", "CEIPST",
+    "CFGNUY", "DDHNOT", "DHHLOR", "DHHNOW", "DHLNOR", "EHILRS",
+    "EIILST", "EILPST", "EIO###", "EMTTTO", "ENSSSU", "GORRVW",
+    "HIRSTV", "HOPRST", "IPRSYY", "JK(QU)WXZ", "NOOTUW", "OOOTTU"
+};
+
 /* Function prototypes */
 
 void welcome();
 void giveInstructions();
 void goodbye();
-void setUpBoard(Grid<char> &boggleGrid);
-void createNonrandomBoard(int n, Grid<char> &boggleGrid);
-void createRandomBoard(int n, Grid<char> &boggleGrid);
-void fillBoggleGrid(int n, string letters, Grid<char> &boggleGrid);
-void humansTurn(Set<string> &playersWordList, Lexicon &english, Grid<char> &boggleGrid);
-void testWordConditions(string &playersWord, Lexicon &english, Set<string> playersWordList);
-void highlightPlayersWord(Grid<char> &booleanGrid);
+void setUpBoard(BoggleBoard &boggleBoard);
+void createNonrandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard);
+void createRandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard);
+void fillBoggleGrid(int numRows, int numCols, string letters, BoggleBoard &boggleBoard);
+void humansTurn(Set<string> &playersWordList, Lexicon &english, BoggleBoard &boggleBoard);
+void testWordConditions(string &playersWord, Lexicon &english, const Set<string> &playersWordList);
+void highlightPlayersWord(BoggleBoard &boggleBoard, CellMask usedCells);
 void computersTurn(Set<string> &computersWordList, Set<string> &playersWordList,
-                   Lexicon &english, Grid <char> &boggleGrid);
-void findBoggleWords(string word, int currentRow, int currentCol,
-                     Grid<char> &boggleGrid, Grid<bool> &booleanGrid,
-                     Set<string> &computersWordList, Set<string> &playersWordList,
-                     Lexicon &english);
+                   Lexicon &english, BoggleBoard &boggleBoard, BoggleSolver &solver);
+void findWordIds(Set<string> &wordList, Lexicon &english, FoundWords &foundWords);
 void printPlayersWords(Set<string> &wordList);
-int chooseBoardSize();
-bool evaluatePlayersWord(string &playersWord, Grid<char> &boggleGrid);
-bool testPlayersWordExists(string word, int currentRow, int currentCol,
-                           Grid<char> &boggleGrid, Grid<char> &booleanGrid);
-Vector<string> shuffleCubes(int n);
-string nonRandomLetters(int n);
+void chooseBoardSize(int &numRows, int &numCols);
+int chooseDimension(string prompt);
+bool evaluatePlayersWord(string &playersWord, BoggleBoard &boggleBoard);
+bool faceMatches(const string &word, BoggleBoard &boggleBoard, int cell);
+bool testPlayersWordExists(string word, int currentCell, CellMask usedCells,
+                           BoggleBoard &boggleBoard);
+Vector<string> shuffleCubes(int numCubes);
+string nonRandomLetters(int numRows, int numCols);
 string createRandomLetters(Vector<string> vec );
 string getPlayersWord();
 
@@ -71,18 +85,21 @@ string getPlayersWord();
 int main() {
     GWindow gw(BOGGLE_WINDOW_WIDTH, BOGGLE_WINDOW_HEIGHT);
     initGBoggle(gw);
-    Grid<char> boggleGrid;
+    BoggleBoard boggleBoard;
     Lexicon english("EnglishWords.dat");
+    english.freeze();
     Set<string> playersWordList;
     Set<string> computersWordList;
+    BoggleSolver solver(english, 0);
+    solver.setMinimumWordLength(MINIMUM_WORD_LENGTH);
     welcome();
     do {
         cout << endl;
         cout << "Do you want instructions? ";
         if(getYesOrNo())  giveInstructions();
-        setUpBoard(boggleGrid);
-        humansTurn(playersWordList, english, boggleGrid);
-        computersTurn(computersWordList, playersWordList, english, boggleGrid);
+        setUpBoard(boggleBoard);
+        humansTurn(playersWordList, english, boggleBoard);
+        computersTurn(computersWordList, playersWordList, english, boggleBoard, solver);
         cout << endl;
         cout << "Do you want to play again? ";
        } while(getYesOrNo());
@@ -146,18 +163,19 @@ void giveInstructions() {
  *
  */
 
-void setUpBoard(Grid<char> &boggleGrid) {
-    int n = chooseBoardSize();
-    boggleGrid.resize(n,n);
+void setUpBoard(BoggleBoard &boggleBoard) {
+    int numRows, numCols;
+    chooseBoardSize(numRows, numCols);
+    boggleBoard.resize(numRows, numCols);
     cout << endl;
     cout << "I'll give you a chance to set up the board to your specification, ";
     cout << "which makes it easier to confirm the boggle program is working correctly." << endl;
     cout << endl;
     cout << "Do you want to force the board configuration? ";
     if(getYesOrNo()) {
-        createNonrandomBoard(n, boggleGrid);
+        createNonrandomBoard(numRows, numCols, boggleBoard);
     } else {
-        createRandomBoard(n, boggleGrid);
+        createRandomBoard(numRows, numCols, boggleBoard);
     }
     cout << endl;
     cout << "Ok, take all the time you want and find all the words you can!" << endl;
@@ -165,133 +183,178 @@ void setUpBoard(Grid<char> &boggleGrid) {
 }
 
 /*
- * Function: int chooseBoardSize()
- * Usage: int n = chooseBoardSize();
+ * Function: void chooseBoardSize(int &numRows, int &numCols)
+ * Usage: chooseBoardSize(numRows, numCols);
  * -----------------
- * This function asks the user if they would like to play on a 4x4
- * or 5x5 board. Since the board is a square it returns the the size
- * of one side as an integer.
+ * This function asks the user if they would like to play on a 4x4, 5x5
+ * or 6x6 board, or else on a board of their own size, which need not be
+ * square. The number of rows and columns are returned through the arguments.
  */
 
-int chooseBoardSize() {
+void chooseBoardSize(int &numRows, int &numCols) {
     cout << endl;
-    cout << "You can choose standard Boggle (4x4 grid) or Big Boggle (5x5)." << endl;
+    cout << "You can choose standard Boggle (4x4 grid), Big Boggle (5x5), Super Big Boggle (6x6), ";
+    cout << "or any other board up to " << MAX_DIMENSION << "x" << MAX_DIMENSION << "." << endl;
     cout << endl;
-    cout << "Would you like Big Boggle? ";
-    if(getYesOrNo()) { return BIG_BOGGLE;} else { return STANDARD;}
+    int n = STANDARD;
+    cout << "Would you like standard Boggle? ";
+    if(!getYesOrNo()) {
+        cout << "Would you like Big Boggle? ";
+        if(getYesOrNo()) {
+            n = BIG_BOGGLE;
+        } else {
+            cout << "Would you like Super Big Boggle? ";
+            if(getYesOrNo()) {
+                n = SUPER_BIG_BOGGLE;
+            } else {
+                numRows = chooseDimension("Number of rows: ");
+                numCols = chooseDimension("Number of columns: ");
+                return;
+            }
+        }
+    }
+    numRows = n;
+    numCols = n;
+}
+
+/*
+ * Function: int chooseDimension(string prompt)
+ * Usage: int numRows = chooseDimension("Number of rows: ");
+ * -----------------
+ * This function asks the user for one dimension of the board until they
+ * give a number from 1 to MAX_DIMENSION.
+ */
+
+int chooseDimension(string prompt) {
+    int n = getInteger(prompt);
+    while(n < 1 || n > MAX_DIMENSION) {
+        cout << "Please enter a number from 1 to " << MAX_DIMENSION << "!" << endl;
+        n = getInteger(prompt);
+    }
+    return n;
 }
 
 /*
- * Function: void createNonrandomBoard(int n, Grid<char> &boggleGrid)
- * Usage: createNonrandomBoard(n, boggleGrid);
+ * Function: void createNonrandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard)
+ * Usage: createNonrandomBoard(numRows, numCols, boggleBoard);
  * -----------------
  * This function creates a boggle board on the console and places letters given by the user onto the board.
  * If the board size is 5x5 then the first 5 letters are the cubes starting with the top row
- * from left to right, the next 5 letters are the second row, and so on.
+ * from left to right, the next 5 letters are the second row, and so on. A face of several letters,
+ * such as (QU), is written in parentheses and fills one cube.
  */
 
-void createNonrandomBoard(int n, Grid<char> &boggleGrid) {
-    string letters = toUpperCase(nonRandomLetters(n));
-    drawBoard(n,n);
-    fillBoggleGrid(n, letters, boggleGrid);
+void createNonrandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard) {
+    string letters = toUpperCase(nonRandomLetters(numRows, numCols));
+    drawBoard(numRows, numCols);
+    fillBoggleGrid(numRows, numCols, letters, boggleBoard);
 }
 
 /*
- * Function: string nonRandomLetters(int n)
- * Usage: string letters = forcedBoardLetters(n);
+ * Function: string nonRandomLetters(int numRows, int numCols)
+ * Usage: string letters = nonRandomLetters(numRows, numCols);
  * -----------------
  * This function asks user for letters to fill the boggle board. If the user does not enter enough
- * letters then s/he is prompted for at least the right amount, which will be n^2.
+ * faces then s/he is prompted for at least the right amount, which will be numRows*numCols. The
+ * string is returned whole, since a face in parentheses takes up more than one character of it.
  */
 
-string nonRandomLetters(int n) {
+string nonRandomLetters(int numRows, int numCols) {
     cout << endl;
-    int numLetters = n*n;
+    int numLetters = numRows*numCols;
     cout << endl;
     cout << "Enter a " << numLetters << "-character string to identify which letters you want on the cubes. ";
-    cout << "The first " << n << " letters are the cubes on the top row from left to right, the next ";
-    cout <<  n << " letters are the second row, and so on." << endl;
+    cout << "The first " << numCols << " letters are the cubes on the top row from left to right, the next ";
+    cout <<  numCols << " letters are the second row, and so on. ";
+    cout << "Put a face of several letters in parentheses, like (QU)." << endl;
     cout << "Enter the string: ";
     string letters = getLine();
-    while(letters.size() < numLetters) {
-        cout << "Please enter at least " << numLetters << "characters!" << endl;
+    while(BoggleBoard::countFaces(letters) < numLetters) {
+        cout << "Please enter at least " << numLetters << " cubes, with at most "
+             << BoggleBoard::MAX_FACE_LENGTH << " letters in each pair of parentheses!" << endl;
         cout << "Try again: ";
         letters = getLine();
     }
-    string boggleLetters = letters.substr(0,numLetters);
-    return boggleLetters;
+    return letters;
 }
 
 /*
- * Function: void fillBoggleGrid(int n, string letters, Grid<char> &boggleGrid)
- * Usage: fillBoggleGrid(int n, letters, boggleGrid);
+ * Function: void fillBoggleGrid(int numRows, int numCols, string letters, BoggleBoard &boggleBoard)
+ * Usage: fillBoggleGrid(numRows, numCols, letters, boggleBoard);
  * -----------------
- * This function takes in a string array of characters and places each leter on the boggle board
- * on the console in order starting at the top and moving by row from left to right.
- * The argument n represents the length of one row (column).
+ * This function takes in an object of the BoggleBoard class that is called by reference and places
+ * each face of the letters string into the board, in order starting at the top and moving by row from
+ * left to right. The argument numCols represents the length of one row.
  *
- * This function also takes in an object of the Grid class that is called by reference and places
- * each of those characters into the grid. This grid will exactly match the Boggle board on the console.
+ * This function also places each face on the boggle board on the console, so the board will exactly
+ * match the Boggle board on the console. A face of several letters is shown as it is printed on a
+ * real cube, with only its first letter in upper case.
  */
 
-void fillBoggleGrid(int n, string letters, Grid<char> &boggleGrid) {
-    for(int i = 0; i < n; i++) {
-        for(int j = 0; j < n; j++) {
-            if(i==0) {
-                labelCube(i,j,letters[j]);
-                boggleGrid.set(i,j,letters[j]);
-            } else {
-                labelCube(i,j,letters[i*n+j]);
-                boggleGrid.set(i,j,letters[i*n+j]);
-            }
+void fillBoggleGrid(int numRows, int numCols, string letters, BoggleBoard &boggleBoard) {
+    boggleBoard.setFaces(letters);
+    for(int i = 0; i < numRows; i++) {
+        for(int j = 0; j < numCols; j++) {
+            string face = boggleBoard.face(boggleBoard.cellIndex(i,j));
+            labelCube(i,j,face.substr(0,1) + toLowerCase(face.substr(1)));
         }
     }
 }
 
 /*
- * Function: void createRandomBoard(int n, Grid<char> &boggleGrid)
- * Usage: createRandomBoard(n, boggleGrid);
+ * Function: void createRandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard)
+ * Usage: createRandomBoard(numRows, numCols, boggleBoard);
  * -----------------
  * This function creates a boggle board on the console and randomly draws letters for that board.
- * First the n*n cubes are shaken to randomly order them on the board and then a letter from each side
+ * First the numRows*numCols cubes are shaken to randomly order them on the board and then a letter from each side
  * is randomly chosen to land face up. If the board size is 5x5 then the first 5 letters are the cubes
  * starting with the top row from left to right, the next 5 letters are the second row, and so on.
  */
 
-void createRandomBoard(int n, Grid<char> &boggleGrid) {    
-    Vector<string> vec = shuffleCubes(n);
+void createRandomBoard(int numRows, int numCols, BoggleBoard &boggleBoard) {
+    Vector<string> vec = shuffleCubes(numRows*numCols);
     string letters = createRandomLetters(vec);
-    drawBoard(n,n);
-    fillBoggleGrid(n, letters, boggleGrid);
+    drawBoard(numRows, numCols);
+    fillBoggleGrid(numRows, numCols, letters, boggleBoard);
 }
 
 /*
- * Function: Vector<string> rearrangeCubes(int n)
- * Usage: Vector<string> vec = rearrangeCubes(n);
+ * Function: Vector<string> shuffleCubes(int numCubes)
+ * Usage: Vector<string> vec = shuffleCubes(numCubes);
  * -----------------
- * This function utilizes the argument 'n' to decide whether to use standard boggle cubes (n=4)
- * or big boggle cubes (n=5). Each cube is stored as a string array within each element of the vector
- * and then the vector is randomly "shaken" to rearrange the position of each cube.
+ * This function utilizes the argument 'numCubes' to decide whether to use standard boggle cubes (16),
+ * super big boggle cubes (36) or big boggle cubes (any other number). Other sizes take as many sets of
+ * big boggle cubes as they need and the board gets a random selection of them. Each cube is stored
+ * as a string array within each element of the vector and then the vector is randomly "shaken" to
+ * rearrange the position of each cube.
  */
 
-Vector<string> shuffleCubes(int n) {
-    Vector<string> vec(n*n);
-    if(n==4) {
-        for(int i = 0; i < n*n ; i++) {
-            vec[i] = STANDARD_CUBES[i];
+Vector<string> shuffleCubes(int numCubes) {
+    Vector<string> vec;
+    if(numCubes == STANDARD*STANDARD) {
+        for(int i = 0; i < numCubes; i++) {
+            vec.add(STANDARD_CUBES[i]);
+        }
+    } else if(numCubes == SUPER_BIG_BOGGLE*SUPER_BIG_BOGGLE) {
+        for(int i = 0; i < numCubes; i++) {
+            vec.add(SUPER_BIG_BOGGLE_CUBES[i]);
         }
     } else {
-        for(int i = 0; i < n*n ; i++) {
-            vec[i] = BIG_BOGGLE_CUBES[i];
+        int numSets = (numCubes + BIG_BOGGLE*BIG_BOGGLE - 1) / (BIG_BOGGLE*BIG_BOGGLE);
+        for(int i = 0; i < numSets*BIG_BOGGLE*BIG_BOGGLE; i++) {
+            vec.add(BIG_BOGGLE_CUBES[i % (BIG_BOGGLE*BIG_BOGGLE)]);
         }
     }
     int randomIndex;
-    for(int i = 0; i < vec.size(); i++) {
+    for(int i = 0; i < numCubes; i++) {
         string temp = vec[i];
         randomIndex = randomInteger(i,vec.size()-1);
         vec[i] = vec[randomIndex];
         vec[randomIndex] = temp;
     }
+    while(vec.size() > numCubes) {
+        vec.remove(vec.size()-1);
+    }
     return vec;
 }
 
@@ -300,17 +363,25 @@ Vector<string> shuffleCubes(int n) {
  * Usage: string letters = createRandomLetters(vec);
  * -----------------
  * This function takes in a vector of strings where each element holds the
- * letters that belong to each side of a boggle dice. It returns a string of
- * vec.size() length where each character at letter[i] is a randomly drawn letter
- * from the dice represented by vec[i].
+ * faces that belong to each side of a boggle dice. It returns a string of
+ * vec.size() faces where face i is randomly drawn from the dice represented
+ * by vec[i]. As in the cube tables, a face of several letters is put in
+ * parentheses.
  */
 
 string createRandomLetters(Vector<string> vec) {
     int randomDiceIndex;
     string letters = "";
     for(int i = 0; i < vec.size(); i++) {
-        randomDiceIndex = randomInteger(0,5);
-        letters += (vec[i][randomDiceIndex]);
+        Vector<string> faces;
+        string face;
+        int pos = 0;
+        while(BoggleBoard::nextFace(vec[i], pos, face)) {
+            faces.add(face);
+        }
+        randomDiceIndex = randomInteger(0,faces.size()-1);
+        face = faces[randomDiceIndex];
+        letters += (face.length() == 1) ? face : "(" + face + ")";
     }
     return letters;
 }
@@ -332,21 +403,21 @@ string getPlayersWord() {
 
 /*
  * Function: void humansTurn(Set<string> &playersWordList,
- *                           Lexicon &english, Grid<char> &boggleGrid);
- * Usage: umansTurn(pplayersWordList, english, boggleGrid)
+ *                           Lexicon &english, BoggleBoard &boggleBoard);
+ * Usage: umansTurn(pplayersWordList, english, boggleBoard)
  * -----------------
  * This function acts as a wrapper function for a human players turn.
  */
 
 
 void humansTurn(Set<string> &playersWordList,
-                Lexicon &english, Grid<char> &boggleGrid) {
+                Lexicon &english, BoggleBoard &boggleBoard) {
     string playersWord = toUpperCase(getPlayersWord());
     if(playersWord != "") {
         testWordConditions(playersWord, english, playersWordList);
     }
     while(playersWord != "") {
-        if(evaluatePlayersWord(playersWord, boggleGrid)) {
+        if(evaluatePlayersWord(playersWord, boggleBoard)) {
             recordWordForPlayer(playersWord, HUMAN);
             playersWordList.add(playersWord);
         }
@@ -370,7 +441,7 @@ void humansTurn(Set<string> &playersWordList,
  *
  */
 
-void testWordConditions(string &playersWord, Lexicon &english, Set<string> playersWordList) {
+void testWordConditions(string &playersWord, Lexicon &english, const Set<string> &playersWordList) {
     while(playersWord.size() < MINIMUM_WORD_LENGTH && playersWord != "") {
         cout << endl;
         cout << "That word does not meet the minimum word length." << endl;
@@ -396,95 +467,95 @@ void testWordConditions(string &playersWord, Lexicon &english, Set<string> playe
 
 
 /*
- * Function: bool evaluatePlayersWord(&playersWord, &boggleGrid);
+ * Function: bool evaluatePlayersWord(&playersWord, &boggleBoard);
  * Usage: bool evaluatePlayersWord());
  * -----------------
  * This function acts as a wrapper for the recursive function that does the heavy lifting when
  * evaluating whether the players word can actually be formed on the boggle board. It loops through
- * every set of coordinates on the grid to evaluate whether that square contains the first letter
- * of the playersWord. If that first letter is not found the function returns false. If that letter is found
- * the first character of the playersWord is removed and the remainder of the string is sent into the
- * recursive function to do the rest of the work. If no match is found then
+ * every cell on the board to evaluate whether the face of that cell begins the playersWord. If no
+ * face does the function returns false. If one does the letters of that face are removed from the
+ * front of the playersWord and the remainder of the string is sent into the recursive function to do
+ * the rest of the work, along with a cell mask marking the first cell as used.
  *
  */
 
-bool evaluatePlayersWord(string &playersWord, Grid<char> &boggleGrid) {
+bool evaluatePlayersWord(string &playersWord, BoggleBoard &boggleBoard) {
     string word = playersWord;
-    Grid<char> booleanGrid(boggleGrid.numRows(), boggleGrid.numCols());
-    for(int i = 0; i < boggleGrid.numRows(); i++) {
-        for(int j = 0; j < boggleGrid.numCols(); j++) {
-            if(boggleGrid[i][j]==word[0]) {
-                string newWord = word.substr(1,word.length()-1);
-                booleanGrid[i][j] = true;
-                if(testPlayersWordExists(newWord, i, j, boggleGrid, booleanGrid)) return true;
-                booleanGrid[i][j] = false;
-            }
+    for(int cell = 0; cell < boggleBoard.numCells(); cell++) {
+        if(faceMatches(word, boggleBoard, cell)) {
+            string newWord = word.substr(boggleBoard.faceLength(cell));
+            if(testPlayersWordExists(newWord, cell, BoggleBoard::cellBit(cell), boggleBoard)) return true;
         }
     }
     return false;
 }
 
+/*
+ * Function: bool faceMatches(const string &word, BoggleBoard &boggleBoard, int cell)
+ * Usage: if(faceMatches(word, boggleBoard, cell)) ...
+ * -----------------
+ * This function returns "true" if word begins with all of the letters on the face of the given cell,
+ * so a word starting with QU matches a (QU) face but a word starting with Q alone does not.
+ */
+
+bool faceMatches(const string &word, BoggleBoard &boggleBoard, int cell) {
+    int length = boggleBoard.faceLength(cell);
+    return word.compare(0, length, boggleBoard.faceAt(cell), length) == 0;
+}
+
 
 /*
- * Function: bool testPlayersWordExists(string word, int currentRow, int currentCol,
- *                                      Grid<char> &boggleGrid, Grid<char> &booleanGrid);
- * Usage: testPlayersWordExists(newWord, i, j, boggleGrid, booleanGrid);
+ * Function: bool testPlayersWordExists(string word, int currentCell, CellMask usedCells,
+ *                                      BoggleBoard &boggleBoard);
+ * Usage: testPlayersWordExists(newWord, cell, BoggleBoard::cellBit(cell), boggleBoard);
  * -----------------
  * This recursive function returns "true" if a word entered by a human player can be found on the
  * current game's boggle board. The function passes:
  *
- * 1.   A word string which has its first character removed if that character is found.
- * 2.   Two integers to store the location of the search match in the wrapper function. These coordinates
- *      identify where the first letter of the players word is found on the boggle board.
- * 3.   The current game's boggle grid. This grid is called by reference
- * 4.   A boolean grid which matches the boggle grid's dimensions. If a square is "true" this means that
- *      the letter on the matching square on the boggle board has already been used. This grid is also
- *      called by reference.
+ * 1.   A word string which has the letters of a face removed from its front if that face is found.
+ * 2.   The cell where the previous letter of the players word was found on the boggle board.
+ * 3.   A cell mask with one bit per square of the board. If a bit is set this means that
+ *      the letter on the matching square on the boggle board has already been used. The mask
+ *      is passed by value, so backing out of a path needs no clean up.
+ * 4.   The current game's boggle board. This board is called by reference
  *
- * The for loops search the 3x3 grid that the matched character from the wrapper function (or from a successful
- * successful recursive call) sits in the middle of. If an adjoining square contains the next letter in the
- * word the recursive call resets that 3x3 grid so that the newly found character is in the middle of the search grid.
+ * The loop searches the neighbours of the current cell, which the board has already worked out. If an
+ * adjoining square contains the next letters in the word the recursive call continues the search
+ * from that square.
  *
  */
 
-bool testPlayersWordExists(string word, int currentRow, int currentCol,
-                           Grid<char> &boggleGrid, Grid<char> &booleanGrid) {
-    for(int i = currentRow-1; i <= currentRow+1; i++) {
-        for(int j = currentCol-1; j <= currentCol+1; j++) {
-            if(boggleGrid.inBounds(i,j) && boggleGrid[i][j] == word[0] && booleanGrid[i][j] != true) {
-                if(word.length() == 1) {
-                    booleanGrid[i][j] = true;
-                    highlightPlayersWord(booleanGrid);
-                    return true;
-                }
-                if(word.length() > 1) {
-                    booleanGrid[i][j] = true;
-                    string newWord = word.substr(1,word.length()-1);
-                    if(testPlayersWordExists(newWord, i, j, boggleGrid, booleanGrid)) return true;
-                }
-            booleanGrid[i][j] = false;
-            }
+bool testPlayersWordExists(string word, int currentCell, CellMask usedCells,
+                           BoggleBoard &boggleBoard) {
+    if(word.length() == 0) {
+        highlightPlayersWord(boggleBoard, usedCells);
+        return true;
+    }
+    const uint8_t *neighbours = boggleBoard.neighbours(currentCell);
+    for(int k = 0; k < boggleBoard.numNeighbours(currentCell); k++) {
+        int cell = neighbours[k];
+        if(faceMatches(word, boggleBoard, cell) && !(usedCells & BoggleBoard::cellBit(cell))) {
+            string newWord = word.substr(boggleBoard.faceLength(cell));
+            if(testPlayersWordExists(newWord, cell, usedCells | BoggleBoard::cellBit(cell), boggleBoard)) return true;
         }
     }
     return false;
 }
 
 /*
- * Function: highlightPlayersWord(Grid<char> &booleanGrid)
- * Usage: highlightPlayersWord(booleanGrid);
+ * Function: highlightPlayersWord(BoggleBoard &boggleBoard, CellMask usedCells)
+ * Usage: highlightPlayersWord(boggleBoard, usedCells);
  * -----------------
  * This function highlights the word the player has entered if it is contained on the board.
  */
 
 
-void highlightPlayersWord(Grid<char> &booleanGrid) {
-    for(int i = 0; i < booleanGrid.numRows(); i++) {
-        for(int j = 0; j < booleanGrid.numRows(); j++) {
-            if(booleanGrid[i][j]==true) {
-                highlightCube(i,j,true);
-                pause(10);
-                highlightCube(i,j,false);
-            }
+void highlightPlayersWord(BoggleBoard &boggleBoard, CellMask usedCells) {
+    for(int cell = 0; cell < boggleBoard.numCells(); cell++) {
+        if(usedCells & BoggleBoard::cellBit(cell)) {
+            highlightCube(boggleBoard.row(cell),boggleBoard.col(cell),true);
+            pause(10);
+            highlightCube(boggleBoard.row(cell),boggleBoard.col(cell),false);
         }
     }
 }
@@ -493,84 +564,47 @@ void highlightPlayersWord(Grid<char> &booleanGrid) {
 
 /*
  * Function: void computersTurn(Set<string> &computersWordList, Set<string> &playersWordList,
-                   Lexicon &english, Grid <char> &boggleGrid)
- * Usage: computersTurn(computersWordList, playersWordList, english, boggleGrid);
+                   Lexicon &english, BoggleBoard &boggleBoard, BoggleSolver &solver)
+ * Usage: computersTurn(computersWordList, playersWordList, english, boggleBoard, solver);
  * -----------------
- * This function acts as a wrapper for the recursive function that does the heavy lifting when
- * evaluating what words the computer can find on the boggle board.
+ * This function acts as a wrapper for the BoggleSolver, which does the heavy lifting when
+ * evaluating what words the computer can find on the boggle board (see bogglesolver.cpp for the
+ * recursive search itself).
+ *
+ * The solver keeps track of words by their ids in the english lexicon (see FoundWords), so the
+ * human player's words are looked up once and passed in as ids to be skipped. The words the computer
+ * found are only turned back into strings and added to the computersWordList once the search is over.
  *
  */
 
 void computersTurn(Set<string> &computersWordList, Set<string> &playersWordList,
-                   Lexicon &english, Grid <char> &boggleGrid) {
-    Grid<bool> booleanGrid(boggleGrid.numRows(), boggleGrid.numCols());
-    for(int i = 0; i < boggleGrid.numRows(); i++) {
-        for(int j = 0; j < boggleGrid.numCols(); j++) {
-            string word = "";
-            word += boggleGrid[i][j];
-            booleanGrid[i][j] = true;
-            findBoggleWords(word, i, j, boggleGrid, booleanGrid, computersWordList, playersWordList, english);
-            booleanGrid[i][j] = false;
-        }
+                   Lexicon &english, BoggleBoard &boggleBoard, BoggleSolver &solver) {
+    FoundWords playersWords;
+    findWordIds(playersWordList, english, playersWords);
+    solver.solve(boggleBoard, playersWords);
+    for(int i = 0; i < solver.words().size(); i++) {
+        computersWordList.add(solver.words().word(i));
     }
     printPlayersWords(computersWordList);
 }
 
 /*
- * Function: findBoggleWords(string word, int i, int j,
-                     Grid<char> &boggleGrid, Grid<bool> &booleanGrid,
-                     Set<string> &computersWordList, Set<string> &playersWordList
-                     Lexicon &english);
- * Usage: findBoggleWords(word, i, j, boggleGrid, booleanGrid,computersWordList);
+ * Function: void findWordIds(Set<string> &wordList, Lexicon &english, FoundWords &foundWords)
+ * Usage: findWordIds(playersWordList, english, playersWords);
  * -----------------
- * This recursive function adds a word to the ComputersWordList if that word can be found on the current game's
- * boggle board, if it hasn't been played already, and if it meets the MINIMUM_WORD_LENGTH.
- * The function passes as arguments:
- *
- * 1.   A word string which initially contains the character passed by the wrapper function as it loops through
- *      every character lying face up on the boggle board.
- * 2.   Two integers to store the location of the search match in the wrapper function. These coordinates
- *      identify where the first letter of the current word being built is found on the boggle board.
- * 3.   The current game's boggle grid. This grid is called by reference
- * 4.   A boolean grid which matches the boggle grid's dimensions. If a square is "true" this means that
- *      the letter on the matching square on the boggle board has already been used. This grid is also
- *      called by reference.
- * 5.   A set containing all the words the computer has found, if any. This set is called by reference.
- * 6.   A set containing all the words the human player found in his/her turn. This set is called by reference.
- * 7.   The english lexicon for testing letter combinations as the algorithm searches combinations on the
- *      boggle board. This lexicon is called by reference.
- *
- * The for loops search the 3x3 grid that the last character in the word string sits in the middle of. As the function
- * passes over the neighboring squares it checks if the prefix that the current word string represents is contained in
- * the english lexicon. If it is, that character is appended to the word string and the function is called recursively.
- *
- * The base case is as follows:
- *
- * 1.   If the english lexicon contains the word, the playersWordList does not contain the word, and the computer has
- *      not already found the word, i.e. it is not contained in the computersWordList then the word is added to
- *      the computersWordList.
- * 2.   If the english lexicon does not contain the prefix that the word string currently represents the search path is killed.
- *
+ * This function clears foundWords and then adds every word of the wordList that is contained in the
+ * english lexicon to it, looking up each word's id by walking a cursor down the lexicon.
  */
 
-
-void findBoggleWords(string word, int currentRow, int currentCol,
-                     Grid<char> &boggleGrid, Grid<bool> &booleanGrid,
-                     Set<string> &computersWordList, Set<string> &playersWordList,
-                     Lexicon &english) {
-    if((word.length() >= MINIMUM_WORD_LENGTH) && !playersWordList.contains(word) &&
-            !computersWordList.contains(word) && english.contains(word)) {
-        computersWordList.add(word);
-    }
-    for(int i = currentRow-1; i <= currentRow+1; i++) {
-        for(int j = currentCol-1; j <= currentCol+1; j++) {
-            if(boggleGrid.inBounds(i,j) && english.containsPrefix(word) && !booleanGrid[i][j]) {
-                word += boggleGrid[i][j];
-                booleanGrid[i][j] = true;
-                findBoggleWords(word, i, j, boggleGrid, booleanGrid, computersWordList, playersWordList, english);
-                booleanGrid[i][j] = false;
-                word = word.substr(0, word.length() - 1);
-            }
+void findWordIds(Set<string> &wordList, Lexicon &english, FoundWords &foundWords) {
+    foundWords.clear(english.wordIdLimit());
+    for (string word : wordList) {
+        Lexicon::Cursor cursor = english.cursor();
+        for(int i = 0; i < word.length() && cursor.isValid(); i++) {
+            cursor = cursor.descend(word[i]);
+        }
+        if(cursor.isWord()) {
+            foundWords.add(cursor.wordId(), word.data(), word.length());
         }
     }
 }
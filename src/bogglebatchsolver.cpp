@@ -0,0 +1,230 @@
+/*
+ * File: bogglebatchsolver.cpp
+ * ---------------------------
+ * Implements the BoggleBatchSolver class.  See bogglebatchsolver.h for the
+ * interface.
+ */
+
+#include "bogglebatchsolver.h"
+#include "error.h"
+using namespace std;
+
+/*
+ * Returns the number, 0 for 'a' through 25 for 'z', of a letter in either
+ * case, or -1 if ch is not a letter.
+ */
+static inline int letterNumber(char ch) {
+    if (ch >= 'a' && ch <= 'z') return ch - 'a';
+    if (ch >= 'A' && ch <= 'Z') return ch - 'A';
+    return -1;
+}
+
+/* Returns the lowest letter in a child mask, which must not be 0 */
+static inline int lowestLetter(int letters) {
+#if defined(__GNUC__)
+    return __builtin_ctz(letters);
+#else
+    return BoggleBoard::lowestCell(CellMask(letters));
+#endif
+}
+
+BoggleBatchSolver::BoggleBatchSolver(const Lexicon& lexicon)
+        : m_lexicon(lexicon) {
+    m_boards = NULL;
+    m_numBoards = 0;
+    m_minimumWordLength = 4;
+}
+
+BoggleBatchSolver::~BoggleBatchSolver() {
+    for (size_t i = 0; i < m_levels.size(); i++) {
+        delete m_levels[i];
+    }
+}
+
+int BoggleBatchSolver::minimumWordLength() const {
+    return m_minimumWordLength;
+}
+
+void BoggleBatchSolver::setMinimumWordLength(int length) {
+    if (length < 1) {
+        error("BoggleBatchSolver::setMinimumWordLength: length must be at least 1");
+    }
+    m_minimumWordLength = length;
+}
+
+int BoggleBatchSolver::numBoards() const {
+    return m_numBoards;
+}
+
+const FoundWords& BoggleBatchSolver::words(int board) const {
+    if (board < 0 || board >= m_numBoards) {
+        error("BoggleBatchSolver::words: board index out of range");
+    }
+    return m_words[board];
+}
+
+int BoggleBatchSolver::score(int board) const {
+    if (board < 0 || board >= m_numBoards) {
+        error("BoggleBatchSolver::score: board index out of range");
+    }
+    return m_scores[board];
+}
+
+/*
+ * Implementation notes: solve
+ * ---------------------------
+ * The lexicon is walked depth first, one level of the walk per letter of
+ * the prefix, on a stack of Levels rather than by recursion.  Each level
+ * holds every path, on any board, that spells out its prefix, already
+ * sorted by the letter that would extend it.  Taking the next letter of a
+ * level therefore finds all the paths for the longer prefix in one list:
+ * if the longer prefix is a word, it is recorded for each board that has
+ * a complete path in the list, and if it begins longer words, the paths
+ * are extended into the next level.  A letter whose list is empty is never
+ * looked at, so the walk stops where no board can follow the lexicon.
+ *
+ * The paths in a list stay grouped by board, since they are extended in
+ * order starting from the boards in order, so a word is added at most once
+ * for each run of paths on the same board.
+ */
+void BoggleBatchSolver::solve(const vector<BoggleBoard>& boards) {
+    m_boards = &boards;
+    m_numBoards = (int) boards.size();
+    if ((int) m_words.size() < m_numBoards) {
+        m_words.resize(m_numBoards);
+    }
+    m_scores.assign(m_numBoards, 0);
+    for (int b = 0; b < m_numBoards; b++) {
+        m_words[b].clear(m_lexicon.wordIdLimit());
+    }
+
+    Level& first = level(0);
+    clearPaths(first);
+    first.cursor = m_lexicon.cursor();
+    for (int b = 0; b < m_numBoards; b++) {
+        const BoggleBoard& board = boards[b];
+        for (int cell = 0; cell < board.numCells(); cell++) {
+            int letter = letterNumber(board.letterAt(cell));
+            if (letter >= 0) {
+                PathEnd path = { BoggleBoard::cellBit(cell), b, (uint8_t) cell,
+                                 (uint8_t) (board.faceLength(cell) > 1 ? 1 : 0) };
+                first.paths[letter].push_back(path);
+                first.filled |= 1 << letter;
+            }
+        }
+    }
+    first.letters = first.cursor.childMask() & first.filled;
+
+    int depth = 0;
+    while (true) {
+        Level& current = level(depth);
+        if (current.letters == 0) {
+            if (depth == 0) {
+                break;
+            }
+            depth--;
+            continue;
+        }
+        int letter = lowestLetter(current.letters);
+        current.letters &= current.letters - 1;
+        const vector<PathEnd>& paths = current.paths[letter];
+        Lexicon::Cursor cursor = current.cursor.descend((char) ('a' + letter));
+        m_letters[depth] = (char) ('a' + letter);
+        int length = depth + 1;
+
+        if (length >= m_minimumWordLength && cursor.isWord()) {
+            int wordId = cursor.wordId();
+            int lastBoard = -1;
+            for (size_t i = 0; i < paths.size(); i++) {
+                if (paths[i].pending == 0 && paths[i].board != lastBoard) {
+                    lastBoard = paths[i].board;
+                    m_words[lastBoard].add(wordId, &m_letters[0], length);
+                }
+            }
+        }
+
+        int childLetters = cursor.childMask();
+        if (childLetters == 0) {
+            continue;
+        }
+        Level& next = level(depth + 1);
+        next.cursor = cursor;
+        extendPaths(paths, childLetters, next);
+        next.letters = childLetters & next.filled;
+        depth++;
+    }
+
+    for (int b = 0; b < m_numBoards; b++) {
+        const FoundWords& found = m_words[b];
+        for (int i = 0; i < found.size(); i++) {
+            m_scores[b] += found.length(i) - m_minimumWordLength + 1;
+        }
+    }
+    m_boards = NULL;
+}
+
+/*
+ * Implementation notes: extendPaths
+ * ---------------------------------
+ * Sorts every one-cube extension of the given paths into the lists of
+ * next by the letter it adds.  A path partway through a face can only go
+ * on with the face's next letter; any other path goes on to each unused
+ * neighbour, adding the first letter of its face.  Extensions by letters
+ * that cannot follow the prefix are dropped here, so they never take up
+ * space in the lists.
+ */
+void BoggleBatchSolver::extendPaths(const vector<PathEnd>& paths, int childLetters,
+                                    Level& next) const {
+    clearPaths(next);
+    for (size_t i = 0; i < paths.size(); i++) {
+        const PathEnd& path = paths[i];
+        const BoggleBoard& board = (*m_boards)[path.board];
+        if (path.pending != 0) {
+            int letter = letterNumber(board.faceAt(path.cell)[path.pending]);
+            if (letter >= 0 && (childLetters & (1 << letter))) {
+                int pending = path.pending + 1;
+                PathEnd longer = { path.usedCells, path.board, path.cell,
+                                   (uint8_t) (pending < board.faceLength(path.cell) ? pending : 0) };
+                next.paths[letter].push_back(longer);
+                next.filled |= 1 << letter;
+            }
+            continue;
+        }
+        for (CellMask open = board.neighbourMask(path.cell) & ~path.usedCells; open != 0;
+                open &= open - 1) {
+            int cell = BoggleBoard::lowestCell(open);
+            int letter = letterNumber(board.letterAt(cell));
+            if (letter >= 0 && (childLetters & (1 << letter))) {
+                PathEnd longer = { path.usedCells | BoggleBoard::cellBit(cell), path.board,
+                                   (uint8_t) cell, (uint8_t) (board.faceLength(cell) > 1 ? 1 : 0) };
+                next.paths[letter].push_back(longer);
+                next.filled |= 1 << letter;
+            }
+        }
+    }
+}
+
+/*
+ * Implementation notes: level
+ * ---------------------------
+ * Levels are made the first time the walk goes that deep and then kept,
+ * lists and all, so that later batches reuse their memory.
+ */
+BoggleBatchSolver::Level& BoggleBatchSolver::level(int depth) {
+    while ((int) m_levels.size() <= depth) {
+        Level* added = new Level();
+        added->letters = 0;
+        added->filled = 0;
+        m_levels.push_back(added);
+        m_letters.push_back('\0');
+    }
+    return *m_levels[depth];
+}
+
+/* Empties the lists of a level, keeping their memory */
+void BoggleBatchSolver::clearPaths(Level& level) {
+    for (int filled = level.filled; filled != 0; filled &= filled - 1) {
+        level.paths[lowestLetter(filled)].clear();
+    }
+    level.filled = 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * File: bogglebatchsolver.h
+ * -------------------------
+ * The bogglebatchsolver.h file defines the BoggleBatchSolver class, which
+ * finds the words of a lexicon on many Boggle boards at once.  It gives the
+ * same words as BoggleSolver, but is meant for scoring large numbers of
+ * boards rather than playing a game.
+ */
+
+#ifndef _bogglebatchsolver_h
+#define _bogglebatchsolver_h
+
+#include <vector>
+#include "boggleboard.h"
+#include "foundwords.h"
+#include "lexicon.h"
+
+/*
+ * Class: BoggleBatchSolver
+ * ------------------------
+ * A batch solver searches a whole list of boards against one lexicon in a
+ * single pass over the lexicon.  BoggleSolver walks the board and follows
+ * the lexicon along, so every board walks the top of the lexicon again;
+ * the batch solver instead walks the lexicon, prefix by prefix, and for
+ * each prefix advances every board on which it can be spelled.  Each part
+ * of the lexicon is read once per batch rather than once per board, which
+ * pays off once the batch has a few dozen boards.  The boards of a batch
+ * may have different sizes.
+ *
+ * <p>Like BoggleSolver, a batch solver keeps its memory between calls to
+ * <code>solve</code>.  The lexicon must outlive the solver and must not be
+ * modified while the solver is in use.
+ *
+ *<pre>
+ *    BoggleBatchSolver solver(english);
+ *    solver.solve(boards);
+ *    for (int i = 0; i < solver.numBoards(); i++) {
+ *       cout << solver.words(i).size() << " words, " << solver.score(i) << endl;
+ *    }
+ *</pre>
+ */
+
+class BoggleBatchSolver {
+public:
+    /*
+     * Constructor: BoggleBatchSolver
+     * Usage: BoggleBatchSolver solver(lexicon);
+     * -----------------------------------------
+     * Creates a batch solver for the given lexicon.
+     */
+    BoggleBatchSolver(const Lexicon& lexicon);
+
+    /*
+     * Destructor: ~BoggleBatchSolver
+     * ------------------------------
+     * Frees the solver's search state.
+     */
+    virtual ~BoggleBatchSolver();
+
+    /*
+     * Methods: minimumWordLength, setMinimumWordLength
+     * Usage: solver.setMinimumWordLength(4);
+     * --------------------------------------
+     * The shortest word the solver reports.  The default is 4.
+     */
+    int minimumWordLength() const;
+    void setMinimumWordLength(int length);
+
+    /*
+     * Method: solve
+     * Usage: solver.solve(boards);
+     * ----------------------------
+     * Finds, for every board in the list, the words that BoggleSolver::solve
+     * would find on it.  The words of each board are found in alphabetical
+     * order and are spelled in lower case.  The results replace those of the
+     * previous call.
+     */
+    void solve(const std::vector<BoggleBoard>& boards);
+
+    /*
+     * Method: numBoards
+     * Usage: int n = solver.numBoards();
+     * ----------------------------------
+     * Returns the number of boards in the last call to solve.
+     */
+    int numBoards() const;
+
+    /*
+     * Methods: words, score
+     * Usage: const FoundWords& words = solver.words(board);
+     *        int points = solver.score(board);
+     * ----------------------------------------------------
+     * Return the words found on the given board of the last call to solve,
+     * and their total score, counted as in BoggleSolver::score.
+     */
+    const FoundWords& words(int board) const;
+    int score(int board) const;
+
+private:
+    /*
+     * Type: PathEnd
+     * -------------
+     * One path on one board that spells out the current prefix.  Only the
+     * cells the path used and its last cell matter for extending it.  If
+     * the prefix ends partway through a face of several letters, pending
+     * is the number of letters of that face already used, and the path
+     * can only go on with the rest of the face; otherwise it is 0.
+     */
+    struct PathEnd {
+        CellMask usedCells;
+        int board;
+        uint8_t cell;
+        uint8_t pending;
+    };
+
+    /*
+     * Type: Level
+     * -----------
+     * The state of the walk at one prefix length: the prefix, the paths
+     * that extend it, sorted by their next letter, and the letters that
+     * are still to be tried.
+     */
+    struct Level {
+        Lexicon::Cursor cursor;
+        std::vector<PathEnd> paths[26];
+        int letters;                        // letters still to try
+        int filled;                         // letters whose paths are not empty
+    };
+
+    Level& level(int depth);
+    static void clearPaths(Level& level);
+    void extendPaths(const std::vector<PathEnd>& paths, int childLetters, Level& next) const;
+
+    /* instance variables */
+    const Lexicon& m_lexicon;
+    const std::vector<BoggleBoard>* m_boards;   // boards of the search in progress
+    std::vector<FoundWords> m_words;            // one per board; may be longer than m_numBoards
+    std::vector<int> m_scores;
+    std::vector<Level*> m_levels;
+    std::vector<char> m_letters;                // letters of the current prefix
+    int m_numBoards;
+    int m_minimumWordLength;
+
+    /* the solver owns its search state, so it cannot be copied */
+    BoggleBatchSolver(const BoggleBatchSolver& src);
+    BoggleBatchSolver& operator =(const BoggleBatchSolver& src);
+};
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * File: boggleboard.cpp
+ * ---------------------
+ * Implements the BoggleBoard class.  See boggleboard.h for the interface.
+ */
+
+#include "boggleboard.h"
+#include <cctype>
+#include "error.h"
+#include "strlib.h"
+using namespace std;
+
+BoggleBoard::BoggleBoard() {
+    m_numRows = 0;
+    m_numCols = 0;
+    resize(0, 0);
+}
+
+BoggleBoard::BoggleBoard(int numRows, int numCols) {
+    m_numRows = 0;
+    m_numCols = 0;
+    resize(numRows, numCols);
+}
+
+void BoggleBoard::resize(int numRows, int numCols) {
+    if (numRows < 0 || numCols < 0 || numRows * numCols > MAX_CELLS) {
+        error("BoggleBoard::resize: invalid dimensions "
+              + integerToString(numRows) + "x" + integerToString(numCols));
+    }
+    for (int cell = 0; cell < MAX_CELLS; cell++) {
+        m_faces[cell][0] = ' ';
+        m_faceLengths[cell] = 1;
+    }
+    for (int letter = 0; letter < 26; letter++) {
+        m_letterMasks[letter] = 0;
+    }
+    if (numRows != m_numRows || numCols != m_numCols) {
+        m_numRows = numRows;
+        m_numCols = numCols;
+        computeNeighbours();
+    }
+}
+
+void BoggleBoard::setLetters(const string& letters) {
+    if ((int) letters.length() < numCells()) {
+        error("BoggleBoard::setLetters: need " + integerToString(numCells())
+              + " letters but got " + integerToString(letters.length()));
+    }
+    for (int cell = 0; cell < numCells(); cell++) {
+        setFirstLetter(cell, letters[cell]);
+        m_faceLengths[cell] = 1;
+    }
+}
+
+void BoggleBoard::setFaces(const string& faces) {
+    int pos = 0;
+    string face;
+    for (int cell = 0; cell < numCells(); cell++) {
+        if (!nextFace(faces, pos, face)) {
+            error("BoggleBoard::setFaces: need " + integerToString(numCells())
+                  + " faces but got " + integerToString(cell));
+        }
+        setFace(cell, face);
+    }
+}
+
+void BoggleBoard::setFace(int cell, const string& face) {
+    if (cell < 0 || cell >= numCells()) {
+        error("BoggleBoard::setFace: cell " + integerToString(cell) + " is out of range");
+    }
+    if (face.empty() || (int) face.length() > MAX_FACE_LENGTH) {
+        error("BoggleBoard::setFace: a face must have 1 to "
+              + integerToString(MAX_FACE_LENGTH) + " letters");
+    }
+    setFirstLetter(cell, face[0]);
+    for (int i = 1; i < (int) face.length(); i++) {
+        m_faces[cell][i] = face[i];
+    }
+    m_faceLengths[cell] = (uint8_t) face.length();
+}
+
+int BoggleBoard::letterSet() const {
+    int letters = 0;
+    for (int letter = 0; letter < 26; letter++) {
+        if (m_letterMasks[letter] != 0) {
+            letters |= 1 << letter;
+        }
+    }
+    return letters;
+}
+
+/*
+ * Implementation notes: setFirstLetter
+ * ------------------------------------
+ * Changes the first letter of a face, moving the cell from the letter
+ * mask of its old letter to that of the new one.
+ */
+void BoggleBoard::setFirstLetter(int cell, char letter) {
+    char old = tolower((unsigned char) m_faces[cell][0]);
+    if (old >= 'a' && old <= 'z') {
+        m_letterMasks[old - 'a'] &= ~cellBit(cell);
+    }
+    m_faces[cell][0] = letter;
+    letter = tolower((unsigned char) letter);
+    if (letter >= 'a' && letter <= 'z') {
+        m_letterMasks[letter - 'a'] |= cellBit(cell);
+    }
+}
+
+bool BoggleBoard::nextFace(const string& text, int& pos, string& face) {
+    if (pos >= (int) text.length()) {
+        return false;
+    }
+    if (text[pos] != '(') {
+        face.assign(1, text[pos++]);
+        return true;
+    }
+    size_t close = text.find(')', pos);
+    if (close == string::npos) {
+        error("BoggleBoard::nextFace: unclosed ( in \"" + text + "\"");
+    }
+    int length = close - pos - 1;
+    if (length < 1 || length > MAX_FACE_LENGTH) {
+        error("BoggleBoard::nextFace: a face must have 1 to "
+              + integerToString(MAX_FACE_LENGTH) + " letters");
+    }
+    face.assign(text, pos + 1, length);
+    pos = close + 1;
+    return true;
+}
+
+/*
+ * Implementation notes: countFaces
+ * --------------------------------
+ * Does the same parse as nextFace, without copying the faces, so that
+ * malformed text can be reported without raising an error.
+ */
+int BoggleBoard::countFaces(const string& text) {
+    int count = 0;
+    for (size_t pos = 0; pos < text.length(); count++) {
+        if (text[pos] != '(') {
+            pos++;
+            continue;
+        }
+        size_t close = text.find(')', pos);
+        if (close == string::npos || close - pos - 1 < 1
+                || close - pos - 1 > (size_t) MAX_FACE_LENGTH) {
+            return -1;
+        }
+        pos = close + 1;
+    }
+    return count;
+}
+
+/*
+ * Implementation notes: computeNeighbours
+ * ---------------------------------------
+ * Walks the 3x3 square around every cell once, keeping the cells that
+ * lie on the board.  The searches then never need a bounds check.
+ */
+void BoggleBoard::computeNeighbours() {
+    for (int cell = 0; cell < numCells(); cell++) {
+        int r = row(cell);
+        int c = col(cell);
+        int count = 0;
+        for (int i = r - 1; i <= r + 1; i++) {
+            for (int j = c - 1; j <= c + 1; j++) {
+                if (i >= 0 && i < m_numRows && j >= 0 && j < m_numCols
+                        && !(i == r && j == c)) {
+                    m_neighbours[cell][count++] = (uint8_t) cellIndex(i, j);
+                }
+            }
+        }
+        m_numNeighbours[cell] = (uint8_t) count;
+        m_neighbourMasks[cell] = ::neighbourMask(m_numRows, m_numCols, cell);
+    }
+}
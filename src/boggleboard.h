@@ -0,0 +1,324 @@
+/*
+ * File: boggleboard.h
+ * -------------------
+ * The boggleboard.h file defines a compact representation of a Boggle
+ * board for the recursive word searches.  The faces are kept in one
+ * flat array indexed by cell number, the cubes used by a partial word are
+ * tracked in a single 64-bit mask, and the neighbours of every cell are
+ * computed once when the board is sized rather than on every step.
+ */
+
+#ifndef _boggleboard_h
+#define _boggleboard_h
+
+#include <stdint.h>
+#include <string>
+
+/*
+ * Type: CellMask
+ * --------------
+ * A set of board cells, one bit per cell.  Bit k is set when cell k is
+ * in the set, so a board may have at most 64 cells.
+ */
+
+typedef uint64_t CellMask;
+
+/*
+ * Function: neighbourMask
+ * Usage: CellMask mask = neighbourMask(numRows, numCols, cell);
+ * -------------------------------------------------------------
+ * Returns the cells adjoining the given cell of a numRows x numCols board
+ * horizontally, vertically or diagonally.  The function is constexpr, so
+ * with constant arguments the mask is worked out by the compiler.
+ */
+
+constexpr CellMask cellIfOnBoard(int numRows, int numCols, int row, int col) {
+    return (row >= 0 && row < numRows && col >= 0 && col < numCols)
+            ? CellMask(1) << (row * numCols + col) : 0;
+}
+
+constexpr CellMask neighbourMaskAt(int numRows, int numCols, int row, int col) {
+    return cellIfOnBoard(numRows, numCols, row - 1, col - 1)
+         | cellIfOnBoard(numRows, numCols, row - 1, col)
+         | cellIfOnBoard(numRows, numCols, row - 1, col + 1)
+         | cellIfOnBoard(numRows, numCols, row, col - 1)
+         | cellIfOnBoard(numRows, numCols, row, col + 1)
+         | cellIfOnBoard(numRows, numCols, row + 1, col - 1)
+         | cellIfOnBoard(numRows, numCols, row + 1, col)
+         | cellIfOnBoard(numRows, numCols, row + 1, col + 1);
+}
+
+constexpr CellMask neighbourMask(int numRows, int numCols, int cell) {
+    return neighbourMaskAt(numRows, numCols, cell / numCols, cell % numCols);
+}
+
+/*
+ * Class: BoggleBoard
+ * ------------------
+ * This class holds the faces lying up on a board of numRows x numCols
+ * cubes.  Cells are numbered from left to right and top to bottom
+ * starting with zero, so the cell at (row, col) is row * numCols + col.
+ *
+ * <p>A face is usually one letter, but may be up to MAX_FACE_LENGTH
+ * letters, like the "Qu" face of the standard cubes; a word that uses the
+ * cube takes all of its letters, in order.  When a board is written out as
+ * text, each face of several letters is put in parentheses, so that
+ * "HIMN(QU)U" lists the six faces H, I, M, N, QU and U.
+ */
+
+class BoggleBoard {
+public:
+    /*
+     * Constant: MAX_CELLS
+     * -------------------
+     * The largest number of cubes a board can hold; one bit of a CellMask
+     * per cube.
+     */
+    static const int MAX_CELLS = 64;
+
+    /*
+     * Constant: MAX_FACE_LENGTH
+     * -------------------------
+     * The largest number of letters on one face of a cube.
+     */
+    static const int MAX_FACE_LENGTH = 3;
+
+    /*
+     * Constructor: BoggleBoard
+     * Usage: BoggleBoard board;
+     *        BoggleBoard board(numRows, numCols);
+     * -------------------------------------------
+     * Creates a board with the given dimensions.  The default constructor
+     * creates an empty 0x0 board.  All faces start out as blanks.
+     */
+    BoggleBoard();
+    BoggleBoard(int numRows, int numCols);
+
+    /*
+     * Method: resize
+     * Usage: board.resize(numRows, numCols);
+     * --------------------------------------
+     * Changes the dimensions of the board and clears its faces.  The
+     * neighbour table is only rebuilt if the dimensions actually change.
+     * An error is raised if the board would hold more than MAX_CELLS cubes.
+     */
+    void resize(int numRows, int numCols);
+
+    /*
+     * Method: setLetters
+     * Usage: board.setLetters(letters);
+     * ---------------------------------
+     * Places the first numCells() characters of letters onto the board
+     * in cell order, one letter per face.  An error is raised if letters
+     * is too short.
+     */
+    void setLetters(const std::string& letters);
+
+    /*
+     * Method: setFaces
+     * Usage: board.setFaces("HIMN(QU)U...");
+     * --------------------------------------
+     * Places the first numCells() faces of a board written out as text
+     * onto the board in cell order.  An error is raised if the text holds
+     * too few faces or a face in parentheses is empty, unclosed or longer
+     * than MAX_FACE_LENGTH letters.
+     */
+    void setFaces(const std::string& faces);
+
+    /*
+     * Method: setFace
+     * Usage: board.setFace(cell, "QU");
+     * ---------------------------------
+     * Places one face, of 1 to MAX_FACE_LENGTH letters, on the given cell.
+     */
+    void setFace(int cell, const std::string& face);
+
+    /*
+     * Function: nextFace
+     * Usage: while (BoggleBoard::nextFace(text, pos, face)) ...
+     * ---------------------------------------------------------
+     * Reads the face that starts at index pos of a board or cube written
+     * out as text, stores its letters in face and moves pos past it.
+     * Returns false, leaving face alone, once pos reaches the end of the
+     * text.  An error is raised if the text is malformed.
+     */
+    static bool nextFace(const std::string& text, int& pos, std::string& face);
+
+    /*
+     * Function: countFaces
+     * Usage: int n = BoggleBoard::countFaces(text);
+     * ---------------------------------------------
+     * Returns the number of faces in a board written out as text, or -1 if
+     * the text is malformed.
+     */
+    static int countFaces(const std::string& text);
+
+    /*
+     * Methods: numRows, numCols, numCells
+     * Usage: int n = board.numCells();
+     * --------------------------------
+     * Return the dimensions of the board and its number of cubes.
+     */
+    int numRows() const {
+        return m_numRows;
+    }
+
+    int numCols() const {
+        return m_numCols;
+    }
+
+    int numCells() const {
+        return m_numRows * m_numCols;
+    }
+
+    /*
+     * Methods: cellIndex, row, col
+     * Usage: int cell = board.cellIndex(row, col);
+     * --------------------------------------------
+     * Convert between (row, col) coordinates and cell numbers.
+     */
+    int cellIndex(int row, int col) const {
+        return row * m_numCols + col;
+    }
+
+    int row(int cell) const {
+        return cell / m_numCols;
+    }
+
+    int col(int cell) const {
+        return cell % m_numCols;
+    }
+
+    /*
+     * Method: letterAt
+     * Usage: char ch = board.letterAt(cell);
+     * --------------------------------------
+     * Returns the first letter on the given cell.  The cell number is not
+     * checked, so this is suitable for the inner loop of a search.
+     */
+    char letterAt(int cell) const {
+        return m_faces[cell][0];
+    }
+
+    /*
+     * Methods: faceAt, faceLength
+     * Usage: const char* face = board.faceAt(cell);
+     *        int length = board.faceLength(cell);
+     * ---------------------------------------------
+     * Return the letters on the given cell, which are not null-terminated,
+     * and their number.  The cell number is not checked.
+     */
+    const char* faceAt(int cell) const {
+        return m_faces[cell];
+    }
+
+    int faceLength(int cell) const {
+        return m_faceLengths[cell];
+    }
+
+    /*
+     * Method: face
+     * Usage: string face = board.face(cell);
+     * --------------------------------------
+     * Returns the letters on the given cell as a string.
+     */
+    std::string face(int cell) const {
+        return std::string(m_faces[cell], m_faceLengths[cell]);
+    }
+
+    /*
+     * Method: letterMask
+     * Usage: CellMask cells = board.letterMask(letter);
+     * -------------------------------------------------
+     * Returns the cells whose faces begin with the given letter, which is
+     * numbered from 0 for 'a' through 25 for 'z' as in the child masks of
+     * Lexicon::Cursor.  Upper and lower case faces count alike.
+     */
+    CellMask letterMask(int letter) const {
+        return m_letterMasks[letter];
+    }
+
+    /*
+     * Method: letterSet
+     * Usage: int letters = board.letterSet();
+     * ---------------------------------------
+     * Returns a mask with bit k set if some face begins with letter k.
+     */
+    int letterSet() const;
+
+    /*
+     * Methods: numNeighbours, neighbours
+     * Usage: for (int k = 0; k < board.numNeighbours(cell); k++) {
+     *            int next = board.neighbours(cell)[k];
+     *            ...
+     *        }
+     * ---------------------------------------------------------
+     * Return the cells adjoining the given cell horizontally, vertically
+     * or diagonally.  Corner cells have 3 neighbours, edge cells 5 and
+     * interior cells 8.
+     */
+    int numNeighbours(int cell) const {
+        return m_numNeighbours[cell];
+    }
+
+    const uint8_t* neighbours(int cell) const {
+        return m_neighbours[cell];
+    }
+
+    /*
+     * Method: neighbourMask
+     * Usage: CellMask next = board.neighbourMask(cell) & ~usedCells;
+     * --------------------------------------------------------------
+     * Returns the same cells as neighbours, as a CellMask.
+     */
+    CellMask neighbourMask(int cell) const {
+        return m_neighbourMasks[cell];
+    }
+
+    /*
+     * Function: cellBit
+     * Usage: visited |= BoggleBoard::cellBit(cell);
+     * ---------------------------------------------
+     * Returns the CellMask containing only the given cell.
+     */
+    static CellMask cellBit(int cell) {
+        return CellMask(1) << cell;
+    }
+
+    /*
+     * Function: lowestCell
+     * Usage: int cell = BoggleBoard::lowestCell(cells);
+     * -------------------------------------------------
+     * Returns the lowest-numbered cell in a set, which must not be empty.
+     * Together with <code>cells &= cells - 1</code>, which removes that
+     * cell, this walks a set in increasing cell order.
+     */
+    static int lowestCell(CellMask cells) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(cells);
+#else
+        int cell = 0;
+        while ((cells & 1) == 0) {
+            cells >>= 1;
+            cell++;
+        }
+        return cell;
+#endif
+    }
+
+private:
+    void computeNeighbours();
+    void setFirstLetter(int cell, char letter);
+
+    /* instance variables */
+    int m_numRows;
+    int m_numCols;
+    char m_faces[MAX_CELLS][MAX_FACE_LENGTH];
+    uint8_t m_faceLengths[MAX_CELLS];
+    CellMask m_letterMasks[26];
+    uint8_t m_numNeighbours[MAX_CELLS];
+    uint8_t m_neighbours[MAX_CELLS][8];
+    CellMask m_neighbourMasks[MAX_CELLS];
+};
+
+#endif
@@ -0,0 +1,452 @@
+/*
+ * File: bogglesolver.cpp
+ * ----------------------
+ * Implements the BoggleSolver class.  See bogglesolver.h for the interface.
+ */
+
+#include "bogglesolver.h"
+#include <cstring>
+#include "error.h"
+using namespace std;
+
+/* Subtrees smaller than this many calls to search are not cached */
+static const long DEAD_END_MIN_VISITS = 16;
+
+/*
+ * Board shapes
+ * ------------
+ * A shape tells the search which cells adjoin a cell.  BoardShape asks the
+ * board, which works for every size.  FixedShape<ROWS, COLS> instead has a
+ * table of neighbour masks that the compiler builds from neighbourMask, so
+ * a search specialized for one of the common sizes reads its neighbours
+ * from a constant table and never has to look at the board's dimensions.
+ */
+
+struct BoardShape {
+    static CellMask neighbours(const BoggleBoard& board, int cell) {
+        return board.neighbourMask(cell);
+    }
+};
+
+template <int... CELLS>
+struct CellList {};
+
+template <int N, int... CELLS>
+struct MakeCellList : MakeCellList<N - 1, N - 1, CELLS...> {};
+
+template <int... CELLS>
+struct MakeCellList<0, CELLS...> {
+    typedef CellList<CELLS...> type;
+};
+
+template <int ROWS, int COLS, class Cells = typename MakeCellList<ROWS * COLS>::type>
+struct FixedShape;
+
+template <int ROWS, int COLS, int... CELLS>
+struct FixedShape<ROWS, COLS, CellList<CELLS...> > {
+    static constexpr CellMask NEIGHBOURS[ROWS * COLS] = { neighbourMask(ROWS, COLS, CELLS)... };
+
+    static CellMask neighbours(const BoggleBoard&, int cell) {
+        return NEIGHBOURS[cell];
+    }
+};
+
+template <int ROWS, int COLS, int... CELLS>
+constexpr CellMask FixedShape<ROWS, COLS, CellList<CELLS...> >::NEIGHBOURS[ROWS * COLS];
+
+/*
+ * Moves cursor down by the letters on the given cell, copying them to
+ * letters as it goes, and returns the cursor for the longer prefix.  Most
+ * faces are a single letter, so faces of several letters are handled out
+ * of line in descendLongFace to keep the search itself small.
+ */
+static Lexicon::Cursor descendLongFace(const BoggleBoard& board, int cell, int start,
+                                       Lexicon::Cursor cursor, char* letters) {
+    const char* face = board.faceAt(cell);
+    for (int i = start; i < board.faceLength(cell) && cursor.isValid(); i++) {
+        letters[i] = face[i];
+        cursor = cursor.descend(face[i]);
+    }
+    return cursor;
+}
+
+static inline Lexicon::Cursor descendFace(const BoggleBoard& board, int cell,
+                                          Lexicon::Cursor cursor, char* letters) {
+    if (board.faceLength(cell) != 1) {
+        return descendLongFace(board, cell, 0, cursor, letters);
+    }
+    letters[0] = board.letterAt(cell);
+    return cursor.descend(letters[0]);
+}
+
+/* Returns the lowest letter in a child mask, which must not be 0 */
+static inline int lowestLetter(int letters) {
+#if defined(__GNUC__)
+    return __builtin_ctz(letters);
+#else
+    return BoggleBoard::lowestCell(CellMask(letters));
+#endif
+}
+
+BoggleSolver::BoggleSolver(const Lexicon& lexicon, int numThreads)
+        : m_lexicon(lexicon) {
+    m_pool = NULL;
+    if (numThreads != 1) {
+        m_pool = new WorkStealingPool(numThreads);
+        if (m_pool->numThreads() == 1) {
+            delete m_pool;
+            m_pool = NULL;
+        }
+    }
+    int numStates = (m_pool == NULL) ? 1 : m_pool->numThreads();
+    for (int i = 0; i < numStates; i++) {
+        SearchState* state = new SearchState();
+        state->generation = 0;
+        state->numVisits = 0;
+        m_states.push_back(state);
+    }
+    m_board = NULL;
+    m_search = NULL;
+    m_boardLetters = 0;
+    m_excluded = NULL;
+    m_minimumWordLength = 4;
+    m_deadEndCacheSize = 0;
+    m_score = 0;
+}
+
+BoggleSolver::~BoggleSolver() {
+    delete m_pool;
+    for (size_t i = 0; i < m_states.size(); i++) {
+        delete m_states[i];
+    }
+}
+
+int BoggleSolver::minimumWordLength() const {
+    return m_minimumWordLength;
+}
+
+void BoggleSolver::setMinimumWordLength(int length) {
+    if (length < 1) {
+        error("BoggleSolver::setMinimumWordLength: length must be at least 1");
+    }
+    m_minimumWordLength = length;
+}
+
+int BoggleSolver::deadEndCacheSize() const {
+    return m_deadEndCacheSize;
+}
+
+/*
+ * Implementation notes: setDeadEndCacheSize
+ * -----------------------------------------
+ * Each thread gets an equal share of the budget, rounded down to a power
+ * of two entries so that a hash can be turned into a slot with a mask.
+ */
+void BoggleSolver::setDeadEndCacheSize(int numBytes) {
+    if (numBytes < 0) {
+        error("BoggleSolver::setDeadEndCacheSize: size must not be negative");
+    }
+    m_deadEndCacheSize = numBytes;
+    size_t perState = numBytes / sizeof(DeadEnd) / m_states.size();
+    size_t numEntries = 0;
+    if (perState > 0) {
+        numEntries = 1;
+        while (numEntries * 2 <= perState) {
+            numEntries *= 2;
+        }
+    }
+    for (size_t i = 0; i < m_states.size(); i++) {
+        DeadEnd empty = { 0, 0, 0, 0 };
+        m_states[i]->deadEnds.assign(numEntries, empty);
+        m_states[i]->generation = 0;
+    }
+}
+
+int BoggleSolver::numThreads() const {
+    return (int) m_states.size();
+}
+
+void BoggleSolver::solve(const BoggleBoard& board) {
+    solveBoard(board, NULL);
+}
+
+void BoggleSolver::solve(const BoggleBoard& board, const FoundWords& excluded) {
+    solveBoard(board, &excluded);
+}
+
+const FoundWords& BoggleSolver::words() const {
+    return m_states[0]->words;
+}
+
+int BoggleSolver::score() const {
+    return m_score;
+}
+
+void BoggleSolver::solveBoard(const BoggleBoard& board, const FoundWords* excluded) {
+    m_board = &board;
+    m_search = searchFunction(board);
+    m_boardLetters = board.letterSet();
+    m_excluded = excluded;
+    if (m_pool == NULL) {
+        solveSerial();
+    } else {
+        solveParallel();
+    }
+    m_board = NULL;
+    m_search = NULL;
+    m_excluded = NULL;
+
+    const FoundWords& found = words();
+    m_score = 0;
+    for (int i = 0; i < found.size(); i++) {
+        m_score += found.length(i) - m_minimumWordLength + 1;
+    }
+}
+
+/*
+ * Implementation notes: solveSerial
+ * ---------------------------------
+ * Starts a search from every cell whose face begins some word.
+ */
+void BoggleSolver::solveSerial() {
+    SearchState& state = *m_states[0];
+    startSearch(state);
+    Lexicon::Cursor root = m_lexicon.cursor();
+    for (int cell = 0; cell < m_board->numCells(); cell++) {
+        Lexicon::Cursor cursor = descendFace(*m_board, cell, root, state.letters);
+        if (cursor.isValid()) {
+            (this->*m_search)(state, cell, m_board->faceLength(cell),
+                              BoggleBoard::cellBit(cell), cursor);
+        }
+    }
+}
+
+/*
+ * Implementation notes: solveParallel
+ * -----------------------------------
+ * Rather than one task per starting cell, there is one task for every pair
+ * of adjoining cells whose two faces begin some word.  There are many more
+ * of those than there are cells and they are much closer in size, so the
+ * threads stay busy until the end, and any thread that runs out of tasks
+ * steals more from the others.  Each thread collects words in its own
+ * SearchState, so the search itself never locks anything; the states are
+ * merged into the first one once every task has finished.  A word spelled
+ * by a single cube belongs to no pair, so it is recorded while the tasks
+ * are being made.
+ */
+void BoggleSolver::solveParallel() {
+    m_firstCells.clear();
+    m_secondCells.clear();
+    m_taskCursors.clear();
+    for (size_t i = 0; i < m_states.size(); i++) {
+        startSearch(*m_states[i]);
+    }
+    Lexicon::Cursor root = m_lexicon.cursor();
+    char letters[2 * BoggleBoard::MAX_FACE_LENGTH];
+    for (int cell = 0; cell < m_board->numCells(); cell++) {
+        Lexicon::Cursor first = descendFace(*m_board, cell, root, letters);
+        if (!first.isValid()) {
+            continue;
+        }
+        int firstLength = m_board->faceLength(cell);
+        if (firstLength >= m_minimumWordLength && first.isWord()
+                && (m_excluded == NULL || !m_excluded->contains(first.wordId()))) {
+            m_states[0]->words.add(first.wordId(), letters, firstLength);
+        }
+        const uint8_t* neighbours = m_board->neighbours(cell);
+        for (int k = 0; k < m_board->numNeighbours(cell); k++) {
+            Lexicon::Cursor second = descendFace(*m_board, neighbours[k], first,
+                                                 letters + firstLength);
+            if (second.isValid()) {
+                m_firstCells.push_back(cell);
+                m_secondCells.push_back(neighbours[k]);
+                m_taskCursors.push_back(second);
+            }
+        }
+    }
+
+    m_pool->run((int) m_taskCursors.size(), [this](int task, int worker) {
+        SearchState& state = *m_states[worker];
+        int first = m_firstCells[task];
+        int second = m_secondCells[task];
+        int firstLength = m_board->faceLength(first);
+        memcpy(state.letters, m_board->faceAt(first), firstLength);
+        memcpy(state.letters + firstLength, m_board->faceAt(second), m_board->faceLength(second));
+        (this->*m_search)(state, second, firstLength + m_board->faceLength(second),
+                          BoggleBoard::cellBit(first) | BoggleBoard::cellBit(second),
+                          m_taskCursors[task]);
+    });
+
+    for (size_t i = 1; i < m_states.size(); i++) {
+        m_states[0]->words.addAll(m_states[i]->words);
+    }
+}
+
+/*
+ * Implementation notes: searchFunction
+ * ------------------------------------
+ * The standard, Big and Super Big Boggle sizes get a search of their own;
+ * any other board uses the neighbour masks the board keeps.
+ */
+BoggleSolver::SearchFunction BoggleSolver::searchFunction(const BoggleBoard& board) {
+    int numRows = board.numRows();
+    int numCols = board.numCols();
+    if (numRows == 4 && numCols == 4) {
+        return &BoggleSolver::search<FixedShape<4, 4> >;
+    } else if (numRows == 5 && numCols == 5) {
+        return &BoggleSolver::search<FixedShape<5, 5> >;
+    } else if (numRows == 6 && numCols == 6) {
+        return &BoggleSolver::search<FixedShape<6, 6> >;
+    }
+    return &BoggleSolver::search<BoardShape>;
+}
+
+/*
+ * Implementation notes: startSearch
+ * ---------------------------------
+ * Empties a thread's word list for a new board and moves its dead-end
+ * cache on to a new generation, which retires all of the old entries at
+ * once.  Only when the generation counter wraps around does the cache
+ * have to be wiped.
+ */
+void BoggleSolver::startSearch(SearchState& state) {
+    state.words.clear(m_lexicon.wordIdLimit());
+    state.generation++;
+    if (state.generation == 0) {
+        DeadEnd empty = { 0, 0, 0, 0 };
+        state.deadEnds.assign(state.deadEnds.size(), empty);
+        state.generation = 1;
+    }
+}
+
+/*
+ * Implementation notes: search
+ * ----------------------------
+ * Finds the words along every path that extends the one given.  On entry,
+ * the first length letters of state.letters spell out a path on the board
+ * that ends at cell, usedCells holds the cells of that path, and cursor
+ * marks the same letters in the lexicon.
+ *
+ * The search is a depth-first walk that keeps its own stack in state.path
+ * rather than recursing, so that the whole walk is one loop with no calls
+ * in it.  Each frame is one cell of the path being followed, and the
+ * letters of the path are written in place to state.letters, so stepping
+ * back from a cell needs no more than popping its frame and taking its
+ * bit out of usedCells.
+ *
+ * On arriving at a cell, the letters so far are recorded if they form a
+ * long enough word that is not excluded.  Then the path is extended to
+ * every unused neighbour whose face keeps the cursor valid, so a path
+ * stops as soon as no word of the lexicon begins with it.
+ *
+ * The extensions are found with masks rather than by trying neighbours
+ * one at a time.  The unused neighbours are the cells adjoining the cell
+ * less usedCells, and the letters that can come next are the cursor's
+ * child mask, less any letter no face on the board begins with.  For each
+ * such letter in turn, the unused neighbours in the board's mask for that
+ * letter are exactly the cells worth visiting, and the cursor only has to
+ * be moved down by the letter once for all of them.  Near the root there
+ * are many possible letters but few of them lie next to the cell, and
+ * deeper down there are only a letter or two, so either way most of the
+ * dead ends are ruled out by a single AND.  Letters and cells are taken
+ * lowest first by peeling off the lowest bit of their masks.
+ *
+ * When the dead-end cache is on, each extension is first looked up in it.
+ * A cached entry for the same cell and prefix whose used cells are a subset
+ * of the ones used now means every path from here was already followed
+ * with at most the same cells blocked, and it found nothing new, so the
+ * extension is skipped.  When the search steps back from an extension,
+ * the extension is cached if it found no new words.  Small subtrees are
+ * not worth a cache slot, so only extensions that took at least
+ * DEAD_END_MIN_VISITS steps are cached.
+ */
+template <class Shape>
+void BoggleSolver::search(SearchState& state, int cell, int length, CellMask usedCells,
+                          Lexicon::Cursor cursor) const {
+    const BoggleBoard& board = *m_board;
+    bool useCache = !state.deadEnds.empty();
+    SearchFrame* root = state.path;
+    SearchFrame* frame = root;
+    frame->cursor = cursor;
+    frame->cell = cell;
+    frame->length = length;
+    while (true) {
+        state.numVisits++;
+        if (frame->length >= m_minimumWordLength && frame->cursor.isWord()
+                && (m_excluded == NULL || !m_excluded->contains(frame->cursor.wordId()))) {
+            state.words.add(frame->cursor.wordId(), state.letters, frame->length);
+        }
+        frame->open = Shape::neighbours(board, frame->cell) & ~usedCells;
+        frame->letters = (frame->open == 0) ? 0 : frame->cursor.childMask() & m_boardLetters;
+        frame->cells = 0;
+
+        /* Moves on to the next extension, stepping back as far as necessary */
+        while (true) {
+            while (frame->cells == 0 && frame->letters != 0) {
+                int letter = lowestLetter(frame->letters);
+                frame->letters &= frame->letters - 1;
+                frame->cells = frame->open & board.letterMask(letter);
+                if (frame->cells != 0) {
+                    frame->letterCursor = frame->cursor.descend((char) ('a' + letter));
+                }
+            }
+            if (frame->cells == 0) {
+                if (frame == root) {
+                    return;
+                }
+                if (useCache && state.words.size() == frame->wordsBefore
+                        && state.numVisits - frame->visitsBefore >= DEAD_END_MIN_VISITS) {
+                    DeadEnd& entry = deadEndSlot(state, frame->cell, frame->cursor);
+                    entry.nodeKey = frame->cursor.nodeKey();
+                    entry.usedCells = usedCells;
+                    entry.cell = frame->cell;
+                    entry.generation = state.generation;
+                }
+                usedCells &= ~BoggleBoard::cellBit(frame->cell);
+                frame--;
+                continue;
+            }
+            int next = BoggleBoard::lowestCell(frame->cells);
+            frame->cells &= frame->cells - 1;
+            char* letters = state.letters + frame->length;
+            letters[0] = board.letterAt(next);
+            Lexicon::Cursor nextCursor = frame->letterCursor;
+            if (board.faceLength(next) != 1) {
+                nextCursor = descendLongFace(board, next, 1, nextCursor, letters);
+                if (!nextCursor.isValid()) {
+                    continue;
+                }
+            }
+            CellMask nextUsed = usedCells | BoggleBoard::cellBit(next);
+            if (useCache) {
+                DeadEnd& slot = deadEndSlot(state, next, nextCursor);
+                if (slot.generation == state.generation && slot.cell == next
+                        && slot.nodeKey == nextCursor.nodeKey()
+                        && (slot.usedCells & ~nextUsed) == 0) {
+                    continue;
+                }
+            }
+            SearchFrame* child = frame + 1;
+            child->cursor = nextCursor;
+            child->cell = next;
+            child->length = frame->length + board.faceLength(next);
+            child->wordsBefore = state.words.size();
+            child->visitsBefore = state.numVisits;
+            usedCells = nextUsed;
+            frame = child;
+            break;
+        }
+    }
+}
+
+/*
+ * Implementation notes: deadEndSlot
+ * ---------------------------------
+ * The cache is direct-mapped: each cell and prefix hashes to exactly one
+ * slot, and a new entry simply overwrites whatever was there.
+ */
+BoggleSolver::DeadEnd& BoggleSolver::deadEndSlot(SearchState& state, int cell,
+                                                 Lexicon::Cursor cursor) const {
+    uint64_t hash = (cursor.nodeKey() ^ (uint64_t(cell) << 56)) * 0x9E3779B97F4A7C15ULL;
+    return state.deadEnds[(hash >> 32) & (state.deadEnds.size() - 1)];
+}
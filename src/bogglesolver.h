@@ -0,0 +1,220 @@
+/*
+ * File: bogglesolver.h
+ * --------------------
+ * The bogglesolver.h file defines the BoggleSolver class, which finds every
+ * word of a lexicon that can be traced out on a Boggle board.  It has no
+ * user interface of its own, so the same solver drives the computer's turn
+ * in the game and the boggle-solve tool that scores boards offline.
+ */
+
+#ifndef _bogglesolver_h
+#define _bogglesolver_h
+
+#include <vector>
+#include "boggleboard.h"
+#include "foundwords.h"
+#include "lexicon.h"
+#include "workstealingpool.h"
+
+/*
+ * Class: BoggleSolver
+ * -------------------
+ * A solver searches boards against one lexicon.  It is meant to be created
+ * once and reused: all of the memory a search needs is kept between calls to
+ * <code>solve</code>, so once the solver has seen a few boards it no longer
+ * allocates anything.  The lexicon must outlive the solver and must not be
+ * modified while the solver is in use.
+ *
+ *<pre>
+ *    BoggleSolver solver(english);
+ *    solver.solve(board);
+ *    for (int i = 0; i < solver.words().size(); i++) {
+ *       cout << solver.words().word(i) << endl;
+ *    }
+ *</pre>
+ */
+
+class BoggleSolver {
+public:
+    /*
+     * Constructor: BoggleSolver
+     * Usage: BoggleSolver solver(lexicon);
+     *        BoggleSolver solver(lexicon, numThreads);
+     * ------------------------------------------------
+     * Creates a solver for the given lexicon.  A solver with more than one
+     * thread splits each search across a WorkStealingPool; a numThreads of
+     * 0 uses one thread per hardware core.
+     */
+    BoggleSolver(const Lexicon& lexicon, int numThreads = 1);
+
+    /*
+     * Destructor: ~BoggleSolver
+     * -------------------------
+     * Frees the solver's search state and stops its threads.
+     */
+    virtual ~BoggleSolver();
+
+    /*
+     * Methods: minimumWordLength, setMinimumWordLength
+     * Usage: solver.setMinimumWordLength(4);
+     * --------------------------------------
+     * The shortest word the solver reports.  The default is 4.
+     */
+    int minimumWordLength() const;
+    void setMinimumWordLength(int length);
+
+    /*
+     * Methods: deadEndCacheSize, setDeadEndCacheSize
+     * Usage: solver.setDeadEndCacheSize(1 << 20);
+     * -------------------------------------------
+     * The number of bytes the solver may spend remembering dead ends.  A
+     * dead end is a point in the search, given by the current cell, the
+     * lexicon prefix and the cells already used, whose continuations
+     * turned up no new words.  If the search later reaches the same cell
+     * and prefix with at least those cells used, it cannot find anything
+     * new there either and skips it.  That only happens when a prefix can
+     * be spelled along several paths, which is common on boards of 6x6 and
+     * up but rare on small ones.  The default is 0, which turns the cache
+     * off.  When the cache is full, newer dead ends replace older ones.
+     */
+    int deadEndCacheSize() const;
+    void setDeadEndCacheSize(int numBytes);
+
+    /*
+     * Method: numThreads
+     * Usage: int n = solver.numThreads();
+     * -----------------------------------
+     * Returns the number of threads each search runs on.
+     */
+    int numThreads() const;
+
+    /*
+     * Method: solve
+     * Usage: solver.solve(board);
+     *        solver.solve(board, excluded);
+     * -------------------------------------
+     * Finds every word of the lexicon that can be formed on the board from
+     * adjoining cubes, using each cube at most once, and that is at least
+     * minimumWordLength() letters long.  A cube whose face has several
+     * letters adds all of them to the word, so a "Qu" face counts as two.
+     * Words whose ids are in excluded, such as the words a human player
+     * has already found, are skipped.  The results replace those of the
+     * previous call.
+     */
+    void solve(const BoggleBoard& board);
+    void solve(const BoggleBoard& board, const FoundWords& excluded);
+
+    /*
+     * Method: words
+     * Usage: const FoundWords& words = solver.words();
+     * ------------------------------------------------
+     * Returns the words found by the last call to solve.  The reference
+     * stays valid until the solver is destroyed, but its contents change
+     * with every call to solve.
+     */
+    const FoundWords& words() const;
+
+    /*
+     * Method: score
+     * Usage: int points = solver.score();
+     * -----------------------------------
+     * Returns the total score of the words found by the last call to solve.
+     * A word of minimumWordLength() letters is worth 1 point, a word one
+     * letter longer 2 points, and so on, matching the game's scoreboard.
+     */
+    int score() const;
+
+private:
+    /*
+     * Type: DeadEnd
+     * -------------
+     * One entry of the dead-end cache.  An entry only counts for the search
+     * whose number matches generation, so starting a new board does not
+     * require wiping the cache.
+     */
+    struct DeadEnd {
+        uint64_t nodeKey;
+        CellMask usedCells;
+        int cell;
+        unsigned generation;
+    };
+
+    /*
+     * Type: SearchFrame
+     * -----------------
+     * One cell of the path the search is following: the cell, the lexicon
+     * prefix and number of letters the path spells out up to it, and the
+     * extensions it has yet to try.  The unused neighbours of the cell are
+     * tried one next letter at a time: letters holds the letters still to
+     * try, cells the neighbours that begin with the current letter, and
+     * letterCursor the prefix extended by that letter.  wordsBefore and
+     * visitsBefore record the search's progress on arriving at the cell,
+     * for the dead-end cache.
+     */
+    struct SearchFrame {
+        CellMask open;
+        CellMask cells;
+        Lexicon::Cursor cursor;
+        Lexicon::Cursor letterCursor;
+        int letters;
+        int cell;
+        int length;
+        int wordsBefore;
+        long visitsBefore;
+    };
+
+    /*
+     * Type: SearchState
+     * -----------------
+     * Everything one thread of a search writes to: the words it has found,
+     * the path it is currently following, as frames and as letters, and
+     * its share of the dead-end cache.
+     */
+    struct SearchState {
+        FoundWords words;
+        SearchFrame path[BoggleBoard::MAX_CELLS];
+        char letters[BoggleBoard::MAX_CELLS * BoggleBoard::MAX_FACE_LENGTH];
+        std::vector<DeadEnd> deadEnds;      // empty if the cache is off, else a power of 2
+        unsigned generation;
+        long numVisits;                     // paths visited so far
+    };
+
+    void solveBoard(const BoggleBoard& board, const FoundWords* excluded);
+    void solveSerial();
+    void solveParallel();
+
+    /*
+     * The search is a template on the shape of the board, which supplies
+     * the neighbours of each cell; see bogglesolver.cpp.  solveBoard picks
+     * the version that fits the board once, for every search it starts.
+     */
+    template <class Shape>
+    void search(SearchState& state, int cell, int length, CellMask usedCells,
+                Lexicon::Cursor cursor) const;
+    typedef void (BoggleSolver::*SearchFunction)(SearchState& state, int cell, int length,
+                                                 CellMask usedCells, Lexicon::Cursor cursor) const;
+    static SearchFunction searchFunction(const BoggleBoard& board);
+    void startSearch(SearchState& state);
+    DeadEnd& deadEndSlot(SearchState& state, int cell, Lexicon::Cursor cursor) const;
+
+    /* instance variables */
+    const Lexicon& m_lexicon;
+    WorkStealingPool* m_pool;               // NULL for a one-thread solver
+    std::vector<SearchState*> m_states;     // one per thread; m_states[0] holds the results
+    std::vector<int> m_firstCells;          // starting cells of the parallel tasks
+    std::vector<int> m_secondCells;         // second cells of the parallel tasks
+    std::vector<Lexicon::Cursor> m_taskCursors;
+    const BoggleBoard* m_board;             // board of the search in progress
+    SearchFunction m_search;                // search for the shape of m_board
+    int m_boardLetters;                     // first letters of the faces of m_board
+    const FoundWords* m_excluded;           // words to skip, or NULL
+    int m_minimumWordLength;
+    int m_deadEndCacheSize;
+    int m_score;
+
+    /* the solver owns its threads and search state, so it cannot be copied */
+    BoggleSolver(const BoggleSolver& src);
+    BoggleSolver& operator =(const BoggleSolver& src);
+};
+
+#endif
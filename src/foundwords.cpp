@@ -0,0 +1,47 @@
+/*
+ * File: foundwords.cpp
+ * --------------------
+ * Implements the FoundWords class.  See foundwords.h for the interface.
+ */
+
+#include "foundwords.h"
+using namespace std;
+
+FoundWords::FoundWords() {
+    m_offsets.push_back(0);
+}
+
+void FoundWords::clear(int wordIdLimit) {
+    m_bits.assign((wordIdLimit + 63) / 64, 0);
+    m_ids.clear();
+    m_offsets.clear();
+    m_offsets.push_back(0);
+    m_text.clear();
+}
+
+bool FoundWords::add(int wordId, const char* text, int length) {
+    uint64_t bit = uint64_t(1) << (wordId & 63);
+    if (m_bits[wordId >> 6] & bit) {
+        return false;
+    }
+    m_bits[wordId >> 6] |= bit;
+    m_ids.push_back(wordId);
+    m_text.append(text, length);
+    m_offsets.push_back((int) m_text.length());
+    return true;
+}
+
+void FoundWords::addAll(const FoundWords& other) {
+    for (int i = 0; i < other.size(); i++) {
+        int start = other.m_offsets[i];
+        add(other.m_ids[i], other.m_text.data() + start, other.m_offsets[i + 1] - start);
+    }
+}
+
+string FoundWords::word(int i) const {
+    return m_text.substr(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+}
+
+void FoundWords::appendWord(int i, string& out) const {
+    out.append(m_text, m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+}
@@ -0,0 +1,121 @@
+/*
+ * File: foundwords.h
+ * ------------------
+ * The foundwords.h file defines the FoundWords class, which records the
+ * words a board search turns up by their lexicon word ids.
+ */
+
+#ifndef _foundwords_h
+#define _foundwords_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Class: FoundWords
+ * -----------------
+ * A set of lexicon words keyed by the ids from <code>Lexicon::Cursor::wordId</code>.
+ * Membership is one bit per id, so testing and adding a word are a shift
+ * and a mask instead of a string search.  The letters of each word are
+ * copied into a single shared buffer when it is first added, and are only
+ * turned into a string when a client asks for the word.  Once a FoundWords
+ * object has grown to fit the words of a search, clearing and refilling it
+ * does not allocate any memory.
+ */
+
+class FoundWords {
+public:
+    /*
+     * Constructor: FoundWords
+     * Usage: FoundWords words;
+     * ------------------------
+     * Creates an empty set that can hold no ids until clear is called.
+     */
+    FoundWords();
+
+    /*
+     * Method: clear
+     * Usage: words.clear(lex.wordIdLimit());
+     * --------------------------------------
+     * Removes all words and makes room for ids between 0 and
+     * wordIdLimit - 1.
+     */
+    void clear(int wordIdLimit);
+
+    /*
+     * Method: contains
+     * Usage: if (words.contains(id)) ...
+     * ----------------------------------
+     * Returns <code>true</code> if the word with the given id is in the set.
+     */
+    bool contains(int wordId) const {
+        return (m_bits[wordId >> 6] >> (wordId & 63)) & 1;
+    }
+
+    /*
+     * Method: add
+     * Usage: if (words.add(id, text, length)) ...
+     * -------------------------------------------
+     * Adds the word with the given id, whose letters are the first length
+     * characters of text.  Returns <code>false</code> without copying the
+     * letters if the word was already in the set.
+     */
+    bool add(int wordId, const char* text, int length);
+
+    /*
+     * Method: addAll
+     * Usage: words.addAll(other);
+     * ---------------------------
+     * Adds every word of other that is not already in this set.
+     */
+    void addAll(const FoundWords& other);
+
+    /*
+     * Method: size
+     * Usage: int n = words.size();
+     * ----------------------------
+     * Returns the number of words in the set.
+     */
+    int size() const {
+        return (int) m_ids.size();
+    }
+
+    /*
+     * Methods: wordId, word, length
+     * Usage: for (int i = 0; i < words.size(); i++) {
+     *            cout << words.word(i) << endl;
+     *        }
+     * -----------------------------------------------
+     * Return the id, the letters and the number of letters of the i-th
+     * word added to the set.
+     */
+    int wordId(int i) const {
+        return m_ids[i];
+    }
+
+    std::string word(int i) const;
+
+    int length(int i) const {
+        return m_offsets[i + 1] - m_offsets[i];
+    }
+
+    /*
+     * Method: appendWord
+     * Usage: words.appendWord(i, line);
+     * ---------------------------------
+     * Appends the letters of the i-th word to out.  Unlike word, this does
+     * not build a new string, so a client printing many words can reuse
+     * one output buffer.
+     */
+    void appendWord(int i, std::string& out) const;
+
+private:
+    /* instance variables */
+    std::vector<uint64_t> m_bits;   // bit k set when id k is in the set
+    std::vector<int> m_ids;         // ids in the order they were added
+    std::vector<int> m_offsets;     // word i occupies [m_offsets[i], m_offsets[i+1]) of m_text
+    std::string m_text;             // letters of all the words, back to back
+};
+
+#endif
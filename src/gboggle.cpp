@@ -31,7 +31,7 @@ using namespace std;
  * To configure fixed spacing, fonts, etc.
  */
 
-const int MAX_DIMENSION = 5;
+const int MAX_DIMENSION = 8;
 
 const double EPSILON = 0.49;           /* constant for antialiasing          */
 const double BOARD_BORDER = 8;         /* width of border around the cubes   */
@@ -66,7 +66,7 @@ const string LABEL_COLOR = "#028040";
  * In addition, the module tracks the count of words listed for each player
  * (to place additional words in the correct location in the displayed word
  * list) and the scores for each player (which must be saved and erased
- * before updating). There is also a 2-d array of the letters currently
+ * before updating). There is also a 2-d array of the faces currently
  * showing on the cubes, to enable drawing them inverted for the
  * highlighting function.
  */
@@ -84,7 +84,7 @@ static struct {
    double fontSize;                    /* font size used for labeling cubes  */
    RectStruct board;                   /* rectangle enscribed the cubes      */
    int numRows, numCols;               /* dimensions of cube layout on board */
-   char letters[MAX_DIMENSION][MAX_DIMENSION];
+   string faces[MAX_DIMENSION][MAX_DIMENSION];
 } gState;
 
 /* Global pointer to the graphics window */
@@ -99,8 +99,8 @@ static GWindow *gwp;
 
 static void fillBox(double x, double y, double width, double height, string color);
 static void drawAndFillRoundedRect(double x, double y, double width, double height, double r, string color);
-static void drawCenteredChar(double centerX, double centerY, char ch, string color);
-static void drawCube(int row, int col, char ch, bool invert);
+static void drawCenteredText(double centerX, double centerY, string text, string color);
+static void drawCube(int row, int col, string face, bool invert);
 static double cubeX(int col);
 static double cubeY(int row);
 static void drawPlayerLabel(Player player, string name);
@@ -145,16 +145,20 @@ void drawBoard(int numRows, int numCols) {
  * Function: labelCube
  * -------------------
  * Exported function used to draw letters on cubes.  Set the 2-d array
- * at this position to hold the letter and then draw the cube in the
- * unhighlighted version with the letter added.
+ * at this position to hold the face and then draw the cube in the
+ * unhighlighted version with the face added.
  */
 
 void labelCube(int row, int col, char letter) {
+   labelCube(row, col, string(1, letter));
+}
+
+void labelCube(int row, int col, string face) {
    if (row < 0 || row >= gState.numRows || col < 0 || col >= gState.numCols) {
       error("labelCube called with invalid row, col arguments.");
    }
-   gState.letters[row][col] = letter;
-   drawCube(row, col, letter, false);
+   gState.faces[row][col] = face;
+   drawCube(row, col, face, false);
 }
 
 /*
@@ -169,7 +173,7 @@ void highlightCube(int row, int col, bool flag) {
    if (row < 0 || row >= gState.numRows || col < 0 || col >= gState.numCols) {
       error("labelCube called with invalid row, col arguments.");
    }
-   drawCube(row, col, gState.letters[row][col], flag);
+   drawCube(row, col, gState.faces[row][col], flag);
 }
 
 /*
@@ -182,24 +186,24 @@ void highlightCube(int row, int col, bool flag) {
 static void drawEmptyCubes() {
    for (int row = 0; row < gState.numRows; row++)
       for (int col = 0; col < gState.numCols; col++)
-          drawCube(row, col, ' ', false);   // erase all cubes, start with blank chars
+          drawCube(row, col, " ", false);   // erase all cubes, start with blank chars
 }
 
 /*
  * Function: drawCube
  * ------------------
- * Draws one cube in its position, including the letter centered in the
+ * Draws one cube in its position, including the face centered in the
  * middle of the cube.  If invert flag is true, reverse background and
  * letter colors.
  */
 
-static void drawCube(int row, int col, char ch, bool invert) {
+static void drawCube(int row, int col, string face, bool invert) {
    drawAndFillRoundedRect(cubeX(col), cubeY(row),
                           gState.cubeSize, gState.cubeSize,
                           gState.cubeSize/5.0,
                           invert ? LETTER_COLOR : DIE_COLOR);
-   drawCenteredChar(cubeX(col) + gState.cubeSize/2.0,
-                    cubeY(row) + gState.cubeSize/2.0, ch,
+   drawCenteredText(cubeX(col) + gState.cubeSize/2.0,
+                    cubeY(row) + gState.cubeSize/2.0, face,
                     invert ? DIE_COLOR : LETTER_COLOR);
 }
 
@@ -325,17 +329,20 @@ static double cubeY(int row) {
 
 static void calculateGeometry(int numRows, int numCols) {
    double boardSize = min(gwp->getWidth()/3, gwp->getHeight() - LABEL_HEIGHT);
-   gState.cubeSize = min((boardSize-BOARD_BORDER)/numRows,
-                         (boardSize-BOARD_BORDER)/numCols) + EPSILON;
-   gState.board.w = gState.board.h = boardSize;
+   double cubeSpace = min((boardSize-BOARD_BORDER)/numRows,
+                          (boardSize-BOARD_BORDER)/numCols);
+   gState.cubeSize = cubeSpace + EPSILON;
+   gState.board.w = cubeSpace*numCols + BOARD_BORDER;
+   gState.board.h = cubeSpace*numRows + BOARD_BORDER;
    gState.board.y = LABEL_HEIGHT;
-   double leftover = gwp->getWidth() - gState.board.w - 2*INDENT;
+   double leftover = gwp->getWidth() - boardSize - 2*INDENT;
    gState.scoreBox[HUMAN].x = INDENT;
    gState.scoreBox[HUMAN].y = gState.scoreBox[COMPUTER].y = gState.board.y;
    gState.scoreBox[HUMAN].h = gState.scoreBox[COMPUTER].h = LABEL_HEIGHT;
    gState.scoreBox[HUMAN].w = leftover*HUMAN_PERCENTAGE;
-   gState.board.x = gState.scoreBox[HUMAN].x + gState.scoreBox[HUMAN].w;
-   gState.scoreBox[COMPUTER].x = gState.board.x + gState.board.w + INDENT;
+   double boardLeft = gState.scoreBox[HUMAN].x + gState.scoreBox[HUMAN].w;
+   gState.board.x = boardLeft + (boardSize - gState.board.w)/2;
+   gState.scoreBox[COMPUTER].x = boardLeft + boardSize + INDENT;
    gState.scoreBox[COMPUTER].w = gwp->getWidth()
                                - gState.scoreBox[COMPUTER].x - INDENT;
    gState.numRows = numRows;
@@ -351,18 +358,19 @@ static void calculateGeometry(int numRows, int numCols) {
 }
 
 /*
- * Function: drawCenteredChar
+ * Function: drawCenteredText
  * --------------------------
  * Used to draw the letters in the center of the cube.
- * Note that this function centers the char both vertically and
- * horizontally around the point specified.
+ * Note that this function centers the text both vertically and
+ * horizontally around the point specified.  A face of several letters
+ * is drawn in a smaller font so that it still fits on the cube.
  */
 
-static void drawCenteredChar(double xc, double yc, char ch, string color) {
-   string s(1, ch);
-   GLabel label(string(1, ch));
-   label.setFont(CUBE_FONT + "-" + integerToString(int(gState.fontSize)));
-   label.setLocation(xc - label.getWidth() / 2, yc + 0.4 * gState.fontSize);
+static void drawCenteredText(double xc, double yc, string text, string color) {
+   double fontSize = gState.fontSize * 1.5 / (text.length() + 0.5);
+   GLabel label(text);
+   label.setFont(CUBE_FONT + "-" + integerToString(int(fontSize)));
+   label.setLocation(xc - label.getWidth() / 2, yc + 0.4 * fontSize);
    gwp->draw(label);
 }
 
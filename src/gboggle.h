@@ -51,11 +51,13 @@ void drawBoard(int numRows, int numCols);
 /*
  * Function: labelCube
  * Usage: labelCube(row, col, letter);
+ *        labelCube(row, col, face);
  * -----------------------------------
- * This function draws the specified letter on the face of the cube
- * at position (row, col).  The cubes are numbered from top to bottom
- * left to right starting  with zero. Therefore, the upper left corner is
- * is (0, 0); the lower right is (numRows-1, numCols-1).  Thus, the call
+ * This function draws the specified letter, or the letters of a face
+ * such as "Qu", on the face of the cube at position (row, col).  The
+ * cubes are numbered from top to bottom left to right starting  with
+ * zero. Therefore, the upper left corner is is (0, 0); the lower right
+ * is (numRows-1, numCols-1).  Thus, the call
  *
  *      labelCube(0, 3, 'D');
  *
@@ -64,6 +66,7 @@ void drawBoard(int numRows, int numCols);
  */
 
 void labelCube(int row, int col, char letter);
+void labelCube(int row, int col, std::string face);
 
 /*
  * Function: highlightCube
@@ -0,0 +1,145 @@
+/*
+ * File: workstealingpool.cpp
+ * --------------------------
+ * Implements the WorkStealingPool class.  See workstealingpool.h for the
+ * interface.
+ */
+
+#include "workstealingpool.h"
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = (int) thread::hardware_concurrency();
+    }
+    if (numThreads <= 0) {
+        numThreads = 1;
+    }
+    m_task = NULL;
+    m_generation = 0;
+    m_remaining = 0;
+    m_shutdown = false;
+    for (int i = 0; i < numThreads; i++) {
+        m_queues.push_back(new WorkQueue());
+    }
+    // worker 0 is whichever thread calls run
+    for (int i = 1; i < numThreads; i++) {
+        m_threads.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_shutdown = true;
+    }
+    m_batchReady.notify_all();
+    for (size_t i = 0; i < m_threads.size(); i++) {
+        m_threads[i].join();
+    }
+    for (size_t i = 0; i < m_queues.size(); i++) {
+        delete m_queues[i];
+    }
+}
+
+int WorkStealingPool::numThreads() const {
+    return (int) m_queues.size();
+}
+
+/*
+ * Implementation notes: run
+ * -------------------------
+ * The tasks are dealt round-robin onto the workers' queues before the
+ * workers are woken, so every worker starts on its own share.  The caller
+ * then works through the batch as worker 0 and finally waits for the
+ * tasks still running on other threads.
+ */
+void WorkStealingPool::run(int numTasks, const function<void(int, int)>& task) {
+    if (numTasks <= 0) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_task = &task;
+        m_remaining = numTasks;
+    }
+    int n = numThreads();
+    for (int i = 0; i < numTasks; i++) {
+        WorkQueue* queue = m_queues[i % n];
+        lock_guard<mutex> guard(queue->lock);
+        queue->tasks.push_back(i);
+    }
+    {
+        lock_guard<mutex> guard(m_lock);
+        m_generation++;
+    }
+    m_batchReady.notify_all();
+
+    drainTasks(0);
+
+    unique_lock<mutex> lock(m_lock);
+    while (m_remaining > 0) {
+        m_batchDone.wait(lock);
+    }
+    m_task = NULL;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    int seenGeneration = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(m_lock);
+            while (!m_shutdown && m_generation == seenGeneration) {
+                m_batchReady.wait(lock);
+            }
+            if (m_shutdown) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+        drainTasks(worker);
+    }
+}
+
+void WorkStealingPool::drainTasks(int worker) {
+    int task;
+    while (takeTask(worker, task)) {
+        (*m_task)(task, worker);
+        lock_guard<mutex> guard(m_lock);
+        m_remaining--;
+        if (m_remaining == 0) {
+            m_batchDone.notify_all();
+        }
+    }
+}
+
+/*
+ * Implementation notes: takeTask
+ * ------------------------------
+ * A worker first takes the most recently dealt task from its own queue.
+ * When that is empty it steals the oldest task from the next worker that
+ * still has one, visiting the other queues in a different order from each
+ * worker so the thieves spread out.
+ */
+bool WorkStealingPool::takeTask(int worker, int& task) {
+    {
+        WorkQueue* own = m_queues[worker];
+        lock_guard<mutex> guard(own->lock);
+        if (!own->tasks.empty()) {
+            task = own->tasks.back();
+            own->tasks.pop_back();
+            return true;
+        }
+    }
+    int n = numThreads();
+    for (int i = 1; i < n; i++) {
+        WorkQueue* victim = m_queues[(worker + i) % n];
+        lock_guard<mutex> guard(victim->lock);
+        if (!victim->tasks.empty()) {
+            task = victim->tasks.front();
+            victim->tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
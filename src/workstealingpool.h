@@ -0,0 +1,101 @@
+/*
+ * File: workstealingpool.h
+ * ------------------------
+ * The workstealingpool.h file defines a small thread pool that spreads a
+ * batch of numbered tasks across a fixed set of threads.  Each thread keeps
+ * its own queue of tasks and, once that runs dry, steals from the others,
+ * so a few expensive tasks do not leave the rest of the threads idle.
+ */
+
+#ifndef _workstealingpool_h
+#define _workstealingpool_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Class: WorkStealingPool
+ * -----------------------
+ * A pool of worker threads for running batches of independent tasks.
+ * The thread that calls <code>run</code> works on the batch as worker 0,
+ * so a pool of one thread runs every task on the caller's thread.
+ */
+
+class WorkStealingPool {
+public:
+    /*
+     * Constructor: WorkStealingPool
+     * Usage: WorkStealingPool pool;
+     *        WorkStealingPool pool(numThreads);
+     * -----------------------------------------
+     * Creates a pool with the given number of worker threads, counting the
+     * calling thread.  If numThreads is 0 or omitted, the pool uses one
+     * thread per hardware core.
+     */
+    explicit WorkStealingPool(int numThreads = 0);
+
+    /*
+     * Destructor: ~WorkStealingPool
+     * -----------------------------
+     * Stops and joins the worker threads.
+     */
+    virtual ~WorkStealingPool();
+
+    /*
+     * Method: numThreads
+     * Usage: int n = pool.numThreads();
+     * ---------------------------------
+     * Returns the number of workers, counting the calling thread.  Worker
+     * indexes passed to tasks are between 0 and numThreads() - 1.
+     */
+    int numThreads() const;
+
+    /*
+     * Method: run
+     * Usage: pool.run(numTasks, task);
+     * --------------------------------
+     * Calls task(taskIndex, workerIndex) once for every taskIndex between 0
+     * and numTasks - 1 and returns when all of the calls have finished.
+     * Calls made on the same worker never overlap, so a task may keep
+     * per-worker results in a slot indexed by workerIndex without locking.
+     * Only one batch may run at a time.
+     */
+    void run(int numTasks, const std::function<void(int, int)>& task);
+
+private:
+    /*
+     * Type: WorkQueue
+     * ---------------
+     * The tasks dealt to one worker.  The owner takes tasks from the back
+     * and thieves take them from the front.
+     */
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+    void workerLoop(int worker);
+    void drainTasks(int worker);
+    bool takeTask(int worker, int& task);
+
+    /* instance variables */
+    std::vector<std::thread> m_threads;
+    std::vector<WorkQueue*> m_queues;           // one per worker, including the caller
+    std::mutex m_lock;                          // guards the fields below
+    std::condition_variable m_batchReady;
+    std::condition_variable m_batchDone;
+    const std::function<void(int, int)>* m_task;
+    int m_generation;                           // bumped once per batch
+    int m_remaining;                            // tasks of this batch not yet finished
+    bool m_shutdown;
+
+    /* the pool owns threads, so it cannot be copied */
+    WorkStealingPool(const WorkStealingPool& src);
+    WorkStealingPool& operator =(const WorkStealingPool& src);
+};
+
+#endif
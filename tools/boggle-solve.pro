@@ -0,0 +1,62 @@
+# Qt Creator project file for the boggle-solve command-line tool
+#
+# boggle-solve solves Boggle boards read from a file or standard input
+# without opening the game window.  See bogglesolve.cpp for its usage.
+# It shares the Stanford C++ library and the board, solver and lexicon
+# code with Boggle.pro, but needs neither spl.jar nor a console window.
+
+TEMPLATE = app
+TARGET = boggle-solve
+CONFIG += console
+CONFIG -= qt app_bundle
+CONFIG += no_include_pwd
+
+ROOT = $$PWD/..
+
+# the library's default main.cpp would clash with the Main of this tool
+SOURCES += $$files($$ROOT/lib/StanfordCPPLib/*.cpp)
+SOURCES -= $$ROOT/lib/StanfordCPPLib/main.cpp
+SOURCES += $$ROOT/lib/StanfordCPPLib/stacktrace/*.cpp
+SOURCES += $$ROOT/src/bogglebatchsolver.cpp
+SOURCES += $$ROOT/src/boggleboard.cpp
+SOURCES += $$ROOT/src/bogglesolver.cpp
+SOURCES += $$ROOT/src/foundwords.cpp
+SOURCES += $$ROOT/src/workstealingpool.cpp
+SOURCES += $$PWD/bogglesolve.cpp
+
+HEADERS += $$ROOT/lib/StanfordCPPLib/*.h
+HEADERS += $$ROOT/src/bogglebatchsolver.h
+HEADERS += $$ROOT/src/boggleboard.h
+HEADERS += $$ROOT/src/bogglesolver.h
+HEADERS += $$ROOT/src/foundwords.h
+HEADERS += $$ROOT/src/workstealingpool.h
+
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/private/
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/stacktrace/
+INCLUDEPATH += $$ROOT/src/
+
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS += -O2
+QMAKE_CXXFLAGS_WARN_ON += -Wall
+QMAKE_CXXFLAGS_WARN_ON += -Wextra
+QMAKE_CXXFLAGS_WARN_ON += -Wno-sign-compare
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+
+unix:!macx {
+    QMAKE_CXXFLAGS += -rdynamic
+    QMAKE_LFLAGS += -rdynamic
+}
+!win32 {
+    QMAKE_CXXFLAGS += -pthread
+    LIBS += -ldl
+    LIBS += -pthread
+}
+win32 {
+    LIBS += -lDbghelp
+    LIBS += -lbfd
+    LIBS += -liberty
+    LIBS += -limagehlp
+}
+
+DEFINES += SPL_PROJECT_VERSION=20141113
@@ -0,0 +1,285 @@
+/*
+ * File: bogglesolve.cpp
+ * ---------------------
+ * The boggle-solve tool finds all the words on a list of Boggle boards
+ * without opening the game window, for scoring large numbers of boards.
+ *
+ * Usage: boggle-solve [options] [board file]
+ *
+ * The boards are read from the named file, or from standard input if no
+ * file is given.  Each line holds one square board: its n*n letters from
+ * left to right and top to bottom, so "AEIOUBCDFGHJKLMN" is a 4x4 board.
+ * With -w, the boards are instead rows of the given width, so with -w 4 the
+ * same line is a 4x4 board and "AEIOUBCD" is a 2x4 one.  A cube face of
+ * several letters is written in parentheses and counts as one cube, so
+ * "AEIOUBCDFGHJKLM(QU)" is also a 4x4 board.  Blank lines are skipped.
+ * For every board the tool writes one line with the board, the number of
+ * words found, the total score and the words themselves, separated by
+ * tabs.  Lines that do not hold a board are reported on the standard error
+ * stream and skipped, and the tool then exits with status 2 once the
+ * remaining boards are solved.
+ *
+ * Options:
+ *   -l file   the lexicon to search (default EnglishWords.dat)
+ *   -m n      the minimum word length (default 4)
+ *   -t n      the number of threads per board, 0 for one per core (default 1)
+ *   -c kb     kilobytes of dead-end cache, which can help on large boards (default 0)
+ *   -q        leave the words out and print only the counts and scores
+ *   -w n      read boards of n columns and as many rows as the letters fill
+ *   -b n      solve the boards n at a time with one walk of the lexicon per batch,
+ *             which is faster for long lists of boards; cannot be used with -t or -c
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "boggleboard.h"
+#include "bogglebatchsolver.h"
+#include "bogglesolver.h"
+#include "lexicon.h"
+#include "strlib.h"
+using namespace std;
+
+/* Function prototypes */
+
+void usage();
+int countArgument(const string &text);
+bool readBoard(istream &input, string &line, int numCols, BoggleBoard &board, int &lineNumber,
+               int &numSkipped);
+void appendResults(const string &letters, const FoundWords &words, int score, bool printWords,
+                   vector<int> &order, string &output);
+
+/* Main program */
+
+int main(int argc, char **argv) {
+    string lexiconFile = "EnglishWords.dat";
+    int minimumWordLength = 4;
+    int numThreads = 1;
+    int cacheKilobytes = 0;
+    bool printWords = true;
+    int numCols = 0;
+    int batchSize = 0;
+    string boardFile = "";
+    for(int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if(arg == "-l" && i + 1 < argc) {
+            lexiconFile = argv[++i];
+        } else if(arg == "-m" && i + 1 < argc) {
+            minimumWordLength = countArgument(argv[++i]);
+            if(minimumWordLength < 1) {
+                usage();
+                return 1;
+            }
+        } else if(arg == "-t" && i + 1 < argc) {
+            numThreads = countArgument(argv[++i]);
+            if(numThreads < 0) {
+                usage();
+                return 1;
+            }
+        } else if(arg == "-c" && i + 1 < argc) {
+            cacheKilobytes = countArgument(argv[++i]);
+            if(cacheKilobytes < 0) {
+                usage();
+                return 1;
+            }
+        } else if(arg == "-q") {
+            printWords = false;
+        } else if(arg == "-w" && i + 1 < argc) {
+            numCols = countArgument(argv[++i]);
+            if(numCols < 1) {
+                usage();
+                return 1;
+            }
+        } else if(arg == "-b" && i + 1 < argc) {
+            batchSize = countArgument(argv[++i]);
+            if(batchSize < 1) {
+                usage();
+                return 1;
+            }
+        } else if(arg[0] != '-' && boardFile == "") {
+            boardFile = arg;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if(batchSize > 0 && (numThreads != 1 || cacheKilobytes != 0)) {
+        usage();
+        return 1;
+    }
+
+    Lexicon lexicon(lexiconFile);
+    lexicon.freeze();
+
+    ifstream file;
+    if(boardFile != "") {
+        file.open(boardFile.c_str());
+        if(file.fail()) {
+            cerr << "boggle-solve: can't open " << boardFile << endl;
+            return 1;
+        }
+    }
+    istream &input = (boardFile == "") ? cin : file;
+
+    // these buffers are reused for every board
+    string output;
+    vector<int> order;
+    int lineNumber = 0;
+    int numSkipped = 0;
+    if(batchSize > 0) {
+        BoggleBatchSolver solver(lexicon);
+        solver.setMinimumWordLength(minimumWordLength);
+        vector<BoggleBoard> boards(batchSize);
+        vector<string> lines(batchSize);
+        while(true) {
+            int numBoards = 0;
+            while(numBoards < batchSize
+                  && readBoard(input, lines[numBoards], numCols, boards[numBoards], lineNumber,
+                               numSkipped)) {
+                numBoards++;
+            }
+            if(numBoards == 0) break;
+            boards.resize(numBoards);       // only the last batch can be short
+            solver.solve(boards);
+            output.clear();
+            for(int i = 0; i < numBoards; i++) {
+                appendResults(lines[i], solver.words(i), solver.score(i), printWords, order, output);
+            }
+            cout.write(output.data(), output.length());
+        }
+    } else {
+        BoggleSolver solver(lexicon, numThreads);
+        solver.setMinimumWordLength(minimumWordLength);
+        solver.setDeadEndCacheSize(cacheKilobytes * 1024);
+        BoggleBoard board;
+        string line;
+        while(readBoard(input, line, numCols, board, lineNumber, numSkipped)) {
+            solver.solve(board);
+            output.clear();
+            appendResults(line, solver.words(), solver.score(), printWords, order, output);
+            cout.write(output.data(), output.length());
+        }
+    }
+    return (numSkipped > 0) ? 2 : 0;
+}
+
+/*
+ * Function: usage
+ * Usage: usage();
+ * -----------------
+ * Prints a summary of the command line to the standard error stream.
+ */
+
+void usage() {
+    cerr << "usage: boggle-solve [-l lexicon] [-m minLength] [-t threads] [-c cacheKB] [-q] [-w cols] [-b batch] [boardfile]" << endl;
+}
+
+/*
+ * Function: int countArgument(const string &text)
+ * Usage: int n = countArgument(argv[++i]);
+ * -----------------
+ * Returns the number given as an option's argument, or -1 if the argument is not written with
+ * digits alone, so that the caller rejects it along with any other number out of range.
+ */
+
+int countArgument(const string &text) {
+    if(text.empty() || text.length() > 9) return -1;
+    int value = 0;
+    for(char ch : text) {
+        if(ch < '0' || ch > '9') return -1;
+        value = value * 10 + (ch - '0');
+    }
+    return value;
+}
+
+/*
+ * Function: bool readBoard(istream &input, string &line, int numCols, BoggleBoard &board, int &lineNumber,
+ *                         int &numSkipped)
+ * Usage: while(readBoard(input, line, numCols, board, lineNumber, numSkipped)) ...
+ * -----------------
+ * This function reads lines from input until it finds one that holds a board, places its faces on
+ * the board and returns true. The faces are left in line, in lower case. A board is square if
+ * numCols is 0 and otherwise has rows of numCols faces. Lines that do not fill a whole board, are
+ * too big for a BoggleBoard or have a malformed face in parentheses are reported on the standard
+ * error stream, counted in numSkipped and skipped. The function returns false at the end of the
+ * input.
+ */
+
+bool readBoard(istream &input, string &line, int numCols, BoggleBoard &board, int &lineNumber,
+               int &numSkipped) {
+    while(getline(input, line)) {
+        lineNumber++;
+        trimInPlace(line);
+        if(line.empty()) continue;
+        toLowerCaseInPlace(line);
+        int length = BoggleBoard::countFaces(line);
+        if(length < 0) {
+            cerr << "boggle-solve: line " << lineNumber << ": a face in parentheses must have 1 to "
+                 << BoggleBoard::MAX_FACE_LENGTH << " letters" << endl;
+            numSkipped++;
+            continue;
+        }
+        int rows = 1;
+        int cols = numCols;
+        if(numCols == 0) {
+            while((rows + 1) * (rows + 1) <= length) rows++;
+            cols = rows;
+        } else {
+            rows = length / numCols;
+        }
+        if(rows * cols != length || length > BoggleBoard::MAX_CELLS) {
+            if(numCols == 0) {
+                cerr << "boggle-solve: line " << lineNumber << ": not a square board of at most "
+                     << BoggleBoard::MAX_CELLS << " cubes" << endl;
+            } else {
+                cerr << "boggle-solve: line " << lineNumber << ": not a board of " << numCols
+                     << " columns and at most " << BoggleBoard::MAX_CELLS << " cubes" << endl;
+            }
+            numSkipped++;
+            continue;
+        }
+        if(board.numRows() != rows || board.numCols() != cols) {
+            board.resize(rows, cols);
+        }
+        board.setFaces(line);
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Function: void appendResults(const string &letters, const FoundWords &words, int score,
+ *                              bool printWords, vector<int> &order, string &output)
+ * Usage: appendResults(line, solver.words(), solver.score(), printWords, order, output);
+ * -----------------
+ * This function appends the output line for one solved board to output. The words are listed in
+ * order of their lexicon word ids, so the output does not depend on the order in which the
+ * solver's threads happened to find them. The order vector is scratch space for the sort.
+ */
+
+void appendResults(const string &letters, const FoundWords &words, int score, bool printWords,
+                   vector<int> &order, string &output) {
+    output += letters;
+    output += '\t';
+    output += integerToString(words.size());
+    output += '\t';
+    output += integerToString(score);
+    if(printWords) {
+        order.clear();
+        for(int i = 0; i < words.size(); i++) {
+            order.push_back(i);
+        }
+        sort(order.begin(), order.end(), [&words](int a, int b) {
+            return words.wordId(a) < words.wordId(b);
+        });
+        for(int i = 0; i < (int) order.size(); i++) {
+            output += (i == 0) ? '\t' : ' ';
+            words.appendWord(order[i], output);
+        }
+    }
+    output += '\n';
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+#
+# File: check-threads.sh
+# ----------------------
+# Checks that boggle-solve finds the same words on one thread as on
+# several, and in batches.  The boards include single cubes and cubes with
+# faces of several letters, which can spell a whole word on their own, and
+# every board is solved with short minimum word lengths as well as the
+# default one.
+#
+# Usage: check-threads.sh [boggle-solve] [board file]
+#
+# Run it where boggle-solve finds its lexicon.  The built-in boards are
+# always checked; a board file adds its boards to them.  The script prints
+# the first difference it finds and exits with status 1, or exits with
+# status 0 if there are none.
+
+SOLVE=${1:-./boggle-solve}
+BOARDS=$(mktemp) || exit 1
+SERIAL=$(mktemp) || exit 1
+OTHER=$(mktemp) || exit 1
+trap 'rm -f "$BOARDS" "$SERIAL" "$OTHER"' EXIT
+
+cat > "$BOARDS" <<EOF
+a
+(the)
+aaaa
+(in)bcd
+(the)(in)(er)s
+(qu)ite
+abcdefghijklmnop
+himn(qu)ueeeeessttt
+(an)(er)(he)(in)(qu)(th)eiotsranldcmupbgwkyvfhjxzeaios
+EOF
+if [ -n "$2" ]; then
+    cat "$2" >> "$BOARDS"
+fi
+
+for minLength in 1 2 3 4; do
+    "$SOLVE" -m $minLength -t 1 "$BOARDS" > "$SERIAL" || exit 1
+    for options in "-t 2" "-t 4" "-t 0" "-b 1" "-b 4"; do
+        "$SOLVE" -m $minLength $options "$BOARDS" > "$OTHER" || exit 1
+        if ! cmp -s "$SERIAL" "$OTHER"; then
+            echo "check-threads: -m $minLength $options differs from -t 1:"
+            diff "$SERIAL" "$OTHER" | head -4
+            exit 1
+        fi
+    done
+done
+echo "check-threads: ok"
@@ -0,0 +1,50 @@
+# Qt Creator project file for the lexicon-compile command-line tool
+#
+# lexicon-compile builds a minimal DAWG from plain word lists and writes it
+# in the binary lexicon format.  See lexiconcompile.cpp for its usage.
+# It needs only the Stanford C++ library, not spl.jar or a console window.
+
+TEMPLATE = app
+TARGET = lexicon-compile
+CONFIG += console
+CONFIG -= qt app_bundle
+CONFIG += no_include_pwd
+
+ROOT = $$PWD/..
+
+# the library's default main.cpp would clash with the Main of this tool
+SOURCES += $$files($$ROOT/lib/StanfordCPPLib/*.cpp)
+SOURCES -= $$ROOT/lib/StanfordCPPLib/main.cpp
+SOURCES += $$ROOT/lib/StanfordCPPLib/stacktrace/*.cpp
+SOURCES += $$PWD/lexiconcompile.cpp
+
+HEADERS += $$ROOT/lib/StanfordCPPLib/*.h
+
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/private/
+INCLUDEPATH += $$ROOT/lib/StanfordCPPLib/stacktrace/
+
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS += -O2
+QMAKE_CXXFLAGS_WARN_ON += -Wall
+QMAKE_CXXFLAGS_WARN_ON += -Wextra
+QMAKE_CXXFLAGS_WARN_ON += -Wno-sign-compare
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+
+unix:!macx {
+    QMAKE_CXXFLAGS += -rdynamic
+    QMAKE_LFLAGS += -rdynamic
+}
+!win32 {
+    QMAKE_CXXFLAGS += -pthread
+    LIBS += -ldl
+    LIBS += -pthread
+}
+win32 {
+    LIBS += -lDbghelp
+    LIBS += -lbfd
+    LIBS += -liberty
+    LIBS += -limagehlp
+}
+
+DEFINES += SPL_PROJECT_VERSION=20141113
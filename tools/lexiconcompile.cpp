@@ -0,0 +1,139 @@
+/*
+ * File: lexiconcompile.cpp
+ * ------------------------
+ * The lexicon-compile tool turns word lists into the compact binary lexicon
+ * format, so that large custom dictionaries load as quickly as the
+ * EnglishWords.dat file that ships with the game.
+ *
+ * Usage: lexicon-compile -o output [word file ...]
+ *
+ * The words are read from the named files, or from standard input if no
+ * file is given.  Each line of a word file holds one word; the words need
+ * not be sorted, and duplicates are dropped.  Case is ignored, and lines
+ * that hold anything other than letters are skipped with a count on the
+ * standard error stream.  An input file may also be a binary lexicon,
+ * which lets a dictionary be extended or converted to the newer format.
+ * The combined words are built into a minimal DAWG and written to the
+ * output file in the native binary format of DawgLexicon, which Lexicon
+ * and DawgLexicon both read.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "dawglexicon.h"
+#include "strlib.h"
+using namespace std;
+
+/* Function prototypes */
+
+void usage();
+void readWords(istream &input, DawgLexicon &lexicon, int &numSkipped);
+bool isBinaryLexicon(const string &filename);
+
+/* Main program */
+
+int main(int argc, char **argv) {
+    string outputFile = "";
+    vector<string> inputFiles;
+    for(int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if(arg == "-o" && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if(arg[0] != '-') {
+            inputFiles.push_back(arg);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if(outputFile == "") {
+        usage();
+        return 1;
+    }
+
+    DawgLexicon lexicon;
+    int numSkipped = 0;
+    if(inputFiles.empty()) {
+        readWords(cin, lexicon, numSkipped);
+    }
+    for(string filename : inputFiles) {
+        if(isBinaryLexicon(filename)) {
+            DawgLexicon binary(filename);
+            for(string word : binary) {
+                lexicon.add(word);
+            }
+        } else {
+            ifstream input(filename.c_str());
+            if(input.fail()) {
+                cerr << "lexicon-compile: can't open " << filename << endl;
+                return 1;
+            }
+            readWords(input, lexicon, numSkipped);
+        }
+    }
+    if(numSkipped > 0) {
+        cerr << "lexicon-compile: skipped " << numSkipped << " lines that were not words" << endl;
+    }
+
+    lexicon.compile();
+    lexicon.writeBinaryFile(outputFile);
+    cerr << "lexicon-compile: wrote " << lexicon.size() << " words to " << outputFile << endl;
+    return 0;
+}
+
+/*
+ * Function: usage
+ * Usage: usage();
+ * -----------------
+ * Prints a summary of the command line to the standard error stream.
+ */
+
+void usage() {
+    cerr << "usage: lexicon-compile -o output [wordfile ...]" << endl;
+}
+
+/*
+ * Function: void readWords(istream &input, DawgLexicon &lexicon, int &numSkipped)
+ * Usage: readWords(input, lexicon, numSkipped);
+ * -----------------
+ * This function adds the word on each line of input to lexicon, in lower case. Blank lines are
+ * ignored, and lines that hold anything but letters are counted in numSkipped and left out.
+ */
+
+void readWords(istream &input, DawgLexicon &lexicon, int &numSkipped) {
+    string line;
+    while(getline(input, line)) {
+        trimInPlace(line);
+        if(line.empty()) continue;
+        toLowerCaseInPlace(line);
+        bool isWord = true;
+        for(size_t i = 0; i < line.length(); i++) {
+            if(line[i] < 'a' || line[i] > 'z') {
+                isWord = false;
+                break;
+            }
+        }
+        if(isWord) {
+            lexicon.add(line);
+        } else {
+            numSkipped++;
+        }
+    }
+}
+
+/*
+ * Function: bool isBinaryLexicon(const string &filename)
+ * Usage: if(isBinaryLexicon(filename)) ...
+ * -----------------
+ * This function returns true if the file begins like one of the binary lexicon formats.
+ */
+
+bool isBinaryLexicon(const string &filename) {
+    ifstream input(filename.c_str(), ios::in | ios::binary);
+    char firstFour[4];
+    input.read(firstFour, 4);
+    return !input.fail() && strncmp(firstFour, "DAWG", 4) == 0;
+}